@@ -1,4 +1,7 @@
 #pragma once
+#include <istream>
+#include <stdexcept>
+#include <string>
 
 // assertion method for user input
 namespace Assert {
@@ -31,6 +34,22 @@ namespace Assert {
         return assertHas(stream, 1, message);
     }
 
+    // assert that string is a nonempty run of decimal digits that fits in 64 bits
+    static const std::string &assertDigits(const std::string &next, const std::string &message) {
+
+        bool isDigits = !next.empty() && next.size() <= 19;
+        for (char c: next) isDigits = isDigits && c >= '0' && c <= '9';
+        if (!isDigits) throw std::invalid_argument("malformed " + message);
+        return next;
+    }
+
+    // assert that text parsed as value
+    static bool assertParsed(bool parsed, const std::string &message) {
+
+        if (!parsed) throw std::invalid_argument("malformed " + message);
+        return parsed;
+    }
+
     // assert that integer is above 0
     static int assertPositive(int num, const std::string &message) {
 
@@ -52,6 +71,27 @@ namespace Assert {
         return num1;
     }
 
+    // assert that byte range has count bytes left
+    static std::size_t assertFits(std::size_t count, std::size_t remain, const std::string &message) {
+
+        if (count > remain) throw std::invalid_argument("truncated " + message);
+        return count;
+    }
+
+    // assert that checksum of bytes read matches checksum stored
+    static unsigned long assertChecksum(unsigned long actual, unsigned long expected, const std::string &message) {
+
+        if (actual != expected) throw std::invalid_argument("corrupt " + message);
+        return actual;
+    }
+
+    // assert that stream or scanner read every value it was asked for
+    static bool assertComplete(bool complete, const std::string &message) {
+
+        if (!complete) throw std::invalid_argument("truncated " + message);
+        return complete;
+    }
+
     // assert that file successfully opened
     static bool assertIsOpen(bool isOpen, const std::string &message) {
 
@@ -59,17 +99,24 @@ namespace Assert {
         return isOpen;
     }
 
+    // assert that search found its key
+    static bool assertFound(bool found, const std::string &message) {
+
+        if (!found) throw std::invalid_argument("undefined " + message);
+        return found;
+    }
+
     // assert that key exists in hash map
-    template<class K, class V>
-    static const K &assertExist(const K &key, const std::map<K, V> &map, const std::string &message) {
+    template<class K, class M>
+    static const K &assertExist(const K &key, const M &map, const std::string &message) {
 
         if (!map.count(key)) throw std::invalid_argument("undefined " + message);
         return key;
     }
 
     // assert that key does not yet exist in hash map
-    template<class K, class V>
-    static const K &assertNonexist(const K &key, const std::map<K, V> &map, const std::string &message) {
+    template<class K, class M>
+    static const K &assertNonexist(const K &key, const M &map, const std::string &message) {
 
         if (map.count(key)) throw std::invalid_argument("predefined " + message);
         return key;
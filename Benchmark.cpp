@@ -0,0 +1,62 @@
+#include <chrono>
+#include <fstream>
+#include "Benchmark.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+void Benchmark::fillCategory(SpeedCategory *speedCategory, int performanceCount, int splitCount) {
+
+    *speedCategory = SpeedCategory("Benchmark");
+    SplitTemplate splitTemplate("Route", splitCount, speedCategory);
+    for (int i = 0; i < splitCount; i++) splitTemplate.getSet()[i] = Name("Split" + std::to_string(i));
+    const SplitTemplate &route = speedCategory->getSplitTemplateSet().addValue(splitTemplate);
+
+    SplitComparison splitComparison("Best", &route);
+    for (int i = 0; i < splitCount; i++) splitComparison.getSet()[i] = Period(30 + i % 7);
+    speedCategory->getSplitComparisonSet().addValue(splitComparison);
+
+    Moment start(Date(0, 0, 2020), Period(0));
+    for (int i = 0; i < performanceCount; i++) {
+        SplitPerformance splitPerformance(Moment(start.getSecondCount() + 3600LL * i), &route);
+        for (int j = 0; j < splitCount; j++)
+            splitPerformance.getSet()[j] = Period(30 + (i * 7 + j * 13) % 600 / 10.0);
+        speedCategory->getSplitPerformanceSet().addValue(splitPerformance);
+
+        SplitPractice splitPractice(i % splitCount, Moment(start.getSecondCount() + 3600LL * i + 1800), &route);
+        splitPractice.getTime() = Period(20 + (i * 11) % 400 / 10.0);
+        speedCategory->getSplitPracticeSet().addValue(splitPractice);
+    }
+}
+
+double Benchmark::timeAction(const std::function<void()> &action) {
+
+    auto start = std::chrono::steady_clock::now();
+    action();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+double Benchmark::megabytePerSecond(std::size_t byteCount, double seconds) {
+
+    return seconds > 0 ? (double) byteCount / 1e6 / seconds : 0;
+}
+
+double Benchmark::nanosecondPerCall(std::size_t callCount, double seconds) {
+
+    return callCount > 0 ? seconds * 1e9 / (double) callCount : 0;
+}
+
+long Benchmark::residentKilobyte() {
+
+#ifdef _WIN32
+    return 0;
+#else
+    std::ifstream statm("/proc/self/statm");
+    long pageCount = 0;
+    long residentCount = 0;
+    if (!(statm >> pageCount >> residentCount)) return 0;
+    return residentCount * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
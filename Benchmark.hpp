@@ -0,0 +1,22 @@
+#pragma once
+#include <functional>
+#include "Split.hpp"
+
+// synthetic workloads for measuring category operations
+namespace Benchmark {
+
+    // fill category with one template and synthetic performances and practices
+    void fillCategory(SpeedCategory *speedCategory, int performanceCount, int splitCount);
+
+    // elapsed seconds of single run of action
+    double timeAction(const std::function<void()> &action);
+
+    // resident set size of process in kilobytes, or 0 where unavailable
+    long residentKilobyte();
+
+    // throughput in megabytes per second
+    double megabytePerSecond(std::size_t byteCount, double seconds);
+
+    // average cost of single call in nanoseconds
+    double nanosecondPerCall(std::size_t callCount, double seconds);
+}
@@ -0,0 +1,205 @@
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include "BinaryIO.hpp"
+#include "Assertion.hpp"
+#include "Checksum.hpp"
+
+const char BinaryWriter::magic[] = "SPLB";
+const int BinaryWriter::magicCount = 4;
+const std::uint32_t BinaryWriter::version = 3;
+const std::uint32_t BinaryWriter::checksumVersion = 2;
+const std::uint32_t BinaryWriter::microsecondVersion = 3;
+
+const std::uint32_t BinaryWriter::nameTag = 0x454d414e;
+
+BinaryWriter::BinaryWriter() : inlineNames(false) {}
+
+BinaryWriter::BinaryWriter(bool inlineNames) : inlineNames(inlineNames) {}
+
+void BinaryWriter::writeU8(std::uint8_t value) { body.push_back((char) value); }
+
+void BinaryWriter::writeU32(std::uint32_t value) {
+
+    char bytes[4];
+    for (int i = 0; i < 4; i++) bytes[i] = (char) (value >> (8 * i));
+    body.append(bytes, 4);
+}
+
+void BinaryWriter::writeI32(std::int32_t value) { writeU32((std::uint32_t) value); }
+
+void BinaryWriter::writeI64(std::int64_t value) {
+
+    char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = (char) ((std::uint64_t) value >> (8 * i));
+    body.append(bytes, 8);
+}
+
+void BinaryWriter::writeF64(double value) {
+
+    std::int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeI64(bits);
+}
+
+void BinaryWriter::writeVarU64(std::uint64_t value) {
+
+    for (; value >= 0x80; value >>= 7) body.push_back((char) (value | 0x80));
+    body.push_back((char) value);
+}
+
+void BinaryWriter::writeBytes(const char *data, std::size_t count) { body.append(data, count); }
+
+void BinaryWriter::writeName(const std::string &name) {
+
+    if (inlineNames) {
+        writeU32((std::uint32_t) name.size());
+        body.append(name);
+        return;
+    }
+
+    auto it = nameIndex.insert({name, (std::uint32_t) nameOrder.size()});
+    if (it.second) nameOrder.push_back(&it.first->first);
+    writeU32(it.first->second);
+}
+
+void BinaryWriter::beginSection(std::uint32_t tag) {
+
+    writeU32(tag);
+    sectionStart.push_back(body.size());
+    writeI64(0);
+    writeU32(0);
+}
+
+void BinaryWriter::endSection() {
+
+    std::size_t start = sectionStart.back();
+    sectionStart.pop_back();
+    std::uint64_t length = body.size() - start - 12;
+    std::uint32_t checksum = Checksum::crc32c(body.data() + start + 12, length);
+    for (int i = 0; i < 8; i++) body[start + i] = (char) (length >> (8 * i));
+    for (int i = 0; i < 4; i++) body[start + 8 + i] = (char) (checksum >> (8 * i));
+}
+
+std::ostream &BinaryWriter::writeTo(std::ostream &stream) const {
+
+    BinaryWriter header;
+    header.body.append(magic, magicCount);
+    header.writeU32(version);
+    header.beginSection(nameTag);
+    header.writeU32((std::uint32_t) nameOrder.size());
+    for (const std::string *name: nameOrder) {
+        header.writeU32((std::uint32_t) name->size());
+        header.body.append(*name);
+    }
+    header.endSection();
+
+    stream.write(header.body.data(), (std::streamsize) header.body.size());
+    stream.write(body.data(), (std::streamsize) body.size());
+    return stream;
+}
+
+BinaryReader::BinaryReader(const char *begin, const char *end) :
+        position(begin), end(end), version(BinaryWriter::version), nameTable(nullptr), speedCategory(nullptr) {}
+
+std::uint32_t BinaryReader::readCount() {
+
+    std::uint32_t count = readU32();
+    Assert::assertFits(count, getRemain(), "category file count");
+    return count;
+}
+
+const char *BinaryReader::readBytes(std::size_t count) {
+
+    Assert::assertFits(count, getRemain(), "category file");
+    const char *result = position;
+    position += count;
+    return result;
+}
+
+std::uint8_t BinaryReader::readU8() { return (std::uint8_t) *readBytes(1); }
+
+std::uint32_t BinaryReader::readU32() {
+
+    const char *bytes = readBytes(4);
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (std::uint32_t) (unsigned char) bytes[i] << (8 * i);
+    return value;
+}
+
+std::int32_t BinaryReader::readI32() { return (std::int32_t) readU32(); }
+
+std::int64_t BinaryReader::readI64() {
+
+    const char *bytes = readBytes(8);
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (std::uint64_t) (unsigned char) bytes[i] << (8 * i);
+    return (std::int64_t) value;
+}
+
+double BinaryReader::readF64() {
+
+    std::int64_t bits = readI64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::uint64_t BinaryReader::readVarU64() {
+
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        auto byte = (std::uint8_t) *readBytes(1);
+        value |= (std::uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+
+    throw std::invalid_argument("overlong category file integer");
+}
+
+NameView BinaryReader::readName() {
+
+    if (nameTable == nullptr) {
+        std::uint32_t size = readCount();
+        return NameView(readBytes(size), size);
+    }
+
+    std::uint32_t index = readU32();
+    Assert::assertRange((int) index, (int) nameTable->size(), "category file name");
+    return (*nameTable)[index];
+}
+
+BinaryReader BinaryReader::readSection(std::uint32_t tag) {
+
+    Assert::assertEqual((int) readU32(), (int) tag, "category file section");
+    std::uint64_t length = (std::uint64_t) readI64();
+    std::uint32_t checksum = version >= BinaryWriter::checksumVersion ? readU32() : 0;
+    Assert::assertFits(length, getRemain(), "category file section");
+    if (version >= BinaryWriter::checksumVersion)
+        Assert::assertChecksum(Checksum::crc32c(position, length), checksum, "category file section");
+
+    BinaryReader section(*this);
+    section.end = position + length;
+    position += length;
+    return section;
+}
+
+BinaryReader &BinaryReader::readHeader(std::vector<NameView> *table) {
+
+    const char *magic = readBytes(BinaryWriter::magicCount);
+    Assert::assertEqual(std::memcmp(magic, BinaryWriter::magic, BinaryWriter::magicCount), 0, "category file header");
+    version = readU32();
+    Assert::assertRange((int) version - 1, (int) BinaryWriter::version, "category file version");
+
+    BinaryReader section = readSection(BinaryWriter::nameTag);
+    std::uint32_t count = section.readCount();
+    table->clear();
+    table->reserve(count);
+    for (std::uint32_t i = 0; i < count; i++) {
+        std::uint32_t size = section.readU32();
+        table->push_back(NameView(section.readBytes(size), size));
+    }
+
+    nameTable = table;
+    return *this;
+}
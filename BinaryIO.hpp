@@ -0,0 +1,195 @@
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class SpeedCategory;
+
+// view of name bytes inside binary file
+class NameView {
+
+private:
+
+    // byte range of name
+    const char *data;
+    std::uint32_t size;
+
+public:
+
+    // constructor
+
+    explicit NameView() : data(nullptr), size(0) {}
+
+    explicit NameView(const char *data, std::uint32_t size) : data(data), size(size) {}
+
+    // getter
+
+    const char *getData() const { return data; }
+
+    std::uint32_t getSize() const { return size; }
+
+    // to string operator
+
+    explicit operator std::string() const { return std::string(data, size); }
+
+    // stream operator
+
+    friend std::ostream &operator<<(std::ostream &stream, const NameView &a) {
+
+        return stream.write(a.data, a.size);
+    }
+};
+
+// little-endian binary writer with name table or inline names for file io
+class BinaryWriter {
+
+private:
+
+    // write names inline instead of into name table
+    bool inlineNames;
+
+    // encoded sections after name table
+    std::string body;
+
+    // offset of length field in open section
+    std::vector<std::size_t> sectionStart;
+
+    // name table in order of first use
+    std::map<std::string, std::uint32_t> nameIndex;
+    std::vector<const std::string *> nameOrder;
+
+public:
+
+    // file header
+    static const char magic[];
+    static const int magicCount;
+    static const std::uint32_t version;
+
+    // first version with checksum after section length
+    static const std::uint32_t checksumVersion;
+
+    // first version with moments in microseconds rather than seconds
+    static const std::uint32_t microsecondVersion;
+
+    // section tag of name table
+    static const std::uint32_t nameTag;
+
+    // constructor
+
+    explicit BinaryWriter();
+
+    explicit BinaryWriter(bool inlineNames);
+
+    // getter
+
+    const std::string &getBody() const { return body; }
+
+    // fixed width primitive
+
+    void writeU8(std::uint8_t value);
+
+    void writeU32(std::uint32_t value);
+
+    void writeI32(std::int32_t value);
+
+    void writeI64(std::int64_t value);
+
+    void writeF64(double value);
+
+    // variable width primitive of seven bits per byte
+
+    void writeVarU64(std::uint64_t value);
+
+    // raw byte range
+
+    void writeBytes(const char *data, std::size_t count);
+
+    // interned name as index into name table or inline name
+
+    void writeName(const std::string &name);
+
+    // section framing
+
+    void beginSection(std::uint32_t tag);
+
+    void endSection();
+
+    // write header, name table and sections to stream
+
+    std::ostream &writeTo(std::ostream &stream) const;
+};
+
+// little-endian binary reader over byte range with name table or inline names for file io
+class BinaryReader {
+
+private:
+
+    // remaining byte range
+    const char *position;
+    const char *end;
+
+    // format version of file
+    std::uint32_t version;
+
+    // name table shared with sections
+    const std::vector<NameView> *nameTable;
+
+    // category for resolving split template references
+    const SpeedCategory *speedCategory;
+
+public:
+
+    // constructor
+
+    explicit BinaryReader(const char *begin, const char *end);
+
+    // getter
+
+    std::size_t getRemain() const { return (std::size_t) (end - position); }
+
+    std::uint32_t getVersion() const { return version; }
+
+    void setVersion(std::uint32_t newVersion) { version = newVersion; }
+
+    const SpeedCategory *getSpeedCategory() const { return speedCategory; }
+
+    void setSpeedCategory(const SpeedCategory *newSpeedCategory) { speedCategory = newSpeedCategory; }
+
+    // fixed width primitive
+
+    std::uint8_t readU8();
+
+    std::uint32_t readU32();
+
+    std::int32_t readI32();
+
+    std::int64_t readI64();
+
+    double readF64();
+
+    // variable width primitive of seven bits per byte
+
+    std::uint64_t readVarU64();
+
+    // element count that fits in byte range left
+
+    std::uint32_t readCount();
+
+    // assert that byte range has count bytes left and skip them
+
+    const char *readBytes(std::size_t count);
+
+    // interned name from name table or inline name without name table
+
+    NameView readName();
+
+    // section framing
+
+    BinaryReader readSection(std::uint32_t tag);
+
+    // read header and name table into table
+
+    BinaryReader &readHeader(std::vector<NameView> *table);
+};
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "BinaryIO.hpp"
+#include "Assertion.hpp"
+#include "BlockCodec.hpp"
+
+// shortest back reference worth encoding
+static const std::size_t minMatchSize = 4;
+
+// hash table of recent positions for match search
+static const int hashBitCount = 14;
+
+static std::uint32_t hashAt(const char *data) {
+
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return (value * 2654435761u) >> (32 - hashBitCount);
+}
+
+std::string BlockCodec::compress(const std::string &raw) {
+
+    const char *data = raw.data();
+    std::size_t size = raw.size();
+    std::vector<std::size_t> recent((std::size_t) 1 << hashBitCount, SIZE_MAX);
+
+    BinaryWriter writer(true);
+    std::size_t literalStart = 0;
+    std::size_t i = 0;
+
+    while (i + minMatchSize <= size) {
+        std::uint32_t hash = hashAt(data + i);
+        std::size_t candidate = recent[hash];
+        recent[hash] = i;
+
+        if (candidate == SIZE_MAX || std::memcmp(data + candidate, data + i, minMatchSize) != 0) {
+            i++;
+            continue;
+        }
+
+        std::size_t matchSize = minMatchSize;
+        while (i + matchSize < size && data[candidate + matchSize] == data[i + matchSize]) matchSize++;
+
+        writer.writeVarU64(i - literalStart);
+        writer.writeBytes(data + literalStart, i - literalStart);
+        writer.writeVarU64(matchSize - minMatchSize + 1);
+        writer.writeVarU64(i - candidate);
+
+        i += matchSize;
+        literalStart = i;
+    }
+
+    writer.writeVarU64(size - literalStart);
+    writer.writeBytes(data + literalStart, size - literalStart);
+    writer.writeVarU64(0);
+    return writer.getBody();
+}
+
+std::string BlockCodec::decompress(const char *data, std::size_t size, std::size_t rawSize) {
+
+    BinaryReader reader(data, data + size);
+    std::string raw;
+    raw.reserve(rawSize);
+
+    while (true) {
+        std::uint64_t literalCount = reader.readVarU64();
+        Assert::assertFits(literalCount, rawSize - raw.size(), "archive block");
+        raw.append(reader.readBytes(literalCount), literalCount);
+
+        std::uint64_t matchCode = reader.readVarU64();
+        if (matchCode == 0) break;
+
+        std::uint64_t matchSize = matchCode + minMatchSize - 1;
+        std::uint64_t offset = reader.readVarU64();
+        Assert::assertFits(matchSize, rawSize - raw.size(), "archive block");
+        if (offset == 0 || offset > raw.size()) throw std::invalid_argument("outranged archive block reference");
+
+        std::size_t from = raw.size() - offset;
+        for (std::uint64_t j = 0; j < matchSize; j++) raw.push_back(raw[from + j]);
+    }
+
+    Assert::assertEqual((int) raw.size(), (int) rawSize, "archive block size");
+    return raw;
+}
+
+std::string BlockCodec::shuffle(const std::string &raw, int width) {
+
+    std::size_t count = raw.size() / width;
+    std::string shuffled(raw.size(), '\0');
+    for (std::size_t i = 0; i < count; i++)
+        for (int b = 0; b < width; b++) shuffled[b * count + i] = raw[i * width + b];
+    return shuffled;
+}
+
+std::string BlockCodec::unshuffle(const std::string &shuffled, int width) {
+
+    std::size_t count = shuffled.size() / width;
+    std::string raw(shuffled.size(), '\0');
+    for (std::size_t i = 0; i < count; i++)
+        for (int b = 0; b < width; b++) raw[i * width + b] = shuffled[b * count + i];
+    return raw;
+}
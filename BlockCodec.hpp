@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+
+// byte-oriented lz77 codec for independently compressed archive blocks
+namespace BlockCodec {
+
+    // compress byte range into sequence of literal runs and back references
+    std::string compress(const std::string &raw);
+
+    // decompress byte range that expands to exactly raw size bytes
+    std::string decompress(const char *data, std::size_t size, std::size_t rawSize);
+
+    // reorder fixed width values so that byte i of every value is contiguous
+    std::string shuffle(const std::string &raw, int width);
+
+    // undo shuffle of fixed width values
+    std::string unshuffle(const std::string &shuffled, int width);
+}
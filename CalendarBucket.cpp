@@ -0,0 +1,81 @@
+#include "CalendarBucket.hpp"
+
+// conversion factor of bucket kernel, as constants so divisions compile to multiplications
+static constexpr long long microsecondPerDay = 24LL * 60 * 60 * 1000000;
+static constexpr int dayPerWeek = 7;
+static constexpr int monthPerYear = 12;
+static constexpr int dayPerLeapYear = 365 * 4 + 1;
+static constexpr int dayPerSkippedLeapYear = dayPerLeapYear * 25 - 1;
+static constexpr int dayPerLeapCycle = dayPerSkippedLeapYear * 4 + 1;
+
+// day count of 1 Mar of year 0 and of first monday, fixed by Date calendar
+static const int dayCountOfMarch = Date(0, 2, 0).dayInAllCount();
+static const int dayCountOfMonday = Date(4, 0, 1970).dayInAllCount();
+
+// month count of day in same closed form as Date, with leap cycle counted from 1 Mar of year 0
+static inline int monthOfDay(int dayCount) {
+
+    int dayFromMarch = dayCount - dayCountOfMarch;
+    int leapCycle = (dayFromMarch >= 0 ? dayFromMarch : dayFromMarch - (dayPerLeapCycle - 1)) / dayPerLeapCycle;
+    int dayInLeapCycle = dayFromMarch - dayPerLeapCycle * leapCycle;
+    int yearInLeapCycle =
+            (dayInLeapCycle - dayInLeapCycle / (dayPerLeapYear - 1) +
+             dayInLeapCycle / dayPerSkippedLeapYear - dayInLeapCycle / (dayPerLeapCycle - 1)) / 365;
+    int dayInYear = dayInLeapCycle - 365 * yearInLeapCycle - yearInLeapCycle / 4 + yearInLeapCycle / 100;
+    int monthFromMarch = (5 * dayInYear + 2) / 153;
+    return (yearInLeapCycle + 400 * leapCycle) * monthPerYear + monthFromMarch + 2;
+}
+
+bool CalendarBucket::parseUnit(const std::string &asString, Unit *result) {
+
+    if (asString == "DAY") *result = day;
+    else if (asString == "WEEK") *result = week;
+    else if (asString == "MONTH") *result = month;
+    else return false;
+    return true;
+}
+
+void CalendarBucket::bucket(const Moment *moment, std::size_t size, Unit unit, int *result) {
+
+    // one loop per unit, so each body is straight-line and left to the compiler to vectorize
+    switch (unit) {
+        case day:
+            for (std::size_t i = 0; i < size; i++)
+                result[i] = (int) (moment[i].getMicrosecondCount() / microsecondPerDay);
+            break;
+        case week:
+            for (std::size_t i = 0; i < size; i++) {
+                int dayFromMonday = (int) (moment[i].getMicrosecondCount() / microsecondPerDay) - dayCountOfMonday;
+                result[i] = (dayFromMonday >= 0 ? dayFromMonday : dayFromMonday - (dayPerWeek - 1)) / dayPerWeek;
+            }
+            break;
+        case month:
+            for (std::size_t i = 0; i < size; i++)
+                result[i] = monthOfDay((int) (moment[i].getMicrosecondCount() / microsecondPerDay));
+            break;
+    }
+}
+
+Date CalendarBucket::firstDay(int bucketId, Unit unit) {
+
+    switch (unit) {
+        case week:
+            return Date(dayCountOfMonday + dayPerWeek * bucketId);
+        case month:
+            return Date(0, bucketId, 0);
+        default:
+            return Date(bucketId);
+    }
+}
+
+std::vector<std::pair<int, PeriodStatistics>> CalendarBucket::summarize(
+        const int *bucketId, const Period *time, std::size_t size) {
+
+    std::vector<std::pair<int, PeriodStatistics>> result;
+    for (std::size_t i = 0; i < size; i++) {
+        if (result.empty() || result.back().first != bucketId[i])
+            result.emplace_back(bucketId[i], PeriodStatistics());
+        result.back().second.add(time[i]);
+    }
+    return result;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+#include "CategorySummary.hpp"
+
+// calendar day, week or month of many moments at once, for grouping values into time series
+namespace CalendarBucket {
+
+    // length of bucket
+    enum Unit { day, week, month };
+
+    // parse unit from DAY, WEEK or MONTH, false if unknown
+    bool parseUnit(const std::string &asString, Unit *result);
+
+    // bucket id of each moment in one branch-free pass: day count, week count from monday, or month count
+    void bucket(const Moment *moment, std::size_t size, Unit unit, int *result);
+
+    // first day in bucket
+    Date firstDay(int bucketId, Unit unit);
+
+    // statistics of times for each run of equal bucket ids, so one entry per bucket when moments are sorted
+    std::vector<std::pair<int, PeriodStatistics>> summarize(const int *bucketId, const Period *time, std::size_t size);
+}
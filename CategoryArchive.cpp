@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "CategoryArchive.hpp"
+#include "Assertion.hpp"
+#include "BlockCodec.hpp"
+#include "Checksum.hpp"
+
+const char CategoryArchive::magic[] = "SPLZ";
+const int CategoryArchive::magicCount = 4;
+const std::uint32_t CategoryArchive::version = 3;
+const std::uint32_t CategoryArchive::microsecondVersion = 3;
+
+const int CategoryArchive::blockSize = 256;
+
+// byte width of encoded period
+static const int periodWidth = 8;
+
+static std::uint64_t zigzag(std::int64_t value) { return ((std::uint64_t) value << 1) ^ (std::uint64_t) (value >> 63); }
+
+static std::int64_t unzigzag(std::uint64_t value) { return (std::int64_t) (value >> 1) ^ -(std::int64_t) (value & 1); }
+
+// encoder of one block with moments as deltas and periods as deltas from previous period at same split index
+class BlockEncoder {
+
+private:
+
+    // moment and template stream
+    BinaryWriter keys;
+
+    // period column before shuffle
+    BinaryWriter periods;
+
+    // previous values
+    std::int64_t previousMoment;
+    std::vector<std::uint64_t> previousPeriod;
+
+public:
+
+    explicit BlockEncoder(std::int64_t firstMoment) : keys(true), periods(true), previousMoment(firstMoment) {}
+
+    void writeMoment(const Moment &moment) {
+
+        keys.writeVarU64(zigzag(moment.getMicrosecondCount() - previousMoment));
+        previousMoment = moment.getMicrosecondCount();
+    }
+
+    void writeIndex(std::uint64_t index) { keys.writeVarU64(index); }
+
+    void writePeriod(int splitIndex, const Period &period) {
+
+        // difference taken modulo 2 to the 64, so periods far apart cannot overflow it
+        auto bits = (std::uint64_t) period.microsecondInAllCount();
+        if ((int) previousPeriod.size() <= splitIndex) previousPeriod.resize(splitIndex + 1, 0);
+        periods.writeI64((std::int64_t) zigzag((std::int64_t) (bits - previousPeriod[splitIndex])));
+        previousPeriod[splitIndex] = bits;
+    }
+
+    // raw block of key stream size, key stream and shuffled period column
+    std::string finish() const {
+
+        BinaryWriter raw(true);
+        raw.writeVarU64(keys.getBody().size());
+        raw.writeBytes(keys.getBody().data(), keys.getBody().size());
+        std::string column = BlockCodec::shuffle(periods.getBody(), periodWidth);
+        raw.writeBytes(column.data(), column.size());
+        return raw.getBody();
+    }
+};
+
+// decoder of one raw block written by block encoder
+class BlockDecoder {
+
+private:
+
+    // decompressed block and unshuffled period column
+    std::string raw;
+    std::string column;
+
+    // remaining streams
+    BinaryReader keys;
+    BinaryReader periods;
+
+    // previous values
+    std::int64_t previousMoment;
+    std::vector<std::uint64_t> previousPeriod;
+
+    // microseconds per unit of moment delta
+    std::int64_t momentUnit;
+
+    // whether periods are microsecond deltas rather than double seconds xor previous double
+    bool isMicrosecondPeriod;
+
+public:
+
+    explicit BlockDecoder(std::string block, std::int64_t firstMoment, std::int64_t momentUnit,
+                          bool isMicrosecondPeriod) :
+            raw(std::move(block)), keys(raw.data(), raw.data() + raw.size()), periods(nullptr, nullptr),
+            previousMoment(firstMoment), momentUnit(momentUnit), isMicrosecondPeriod(isMicrosecondPeriod) {
+
+        std::uint64_t keySize = keys.readVarU64();
+        Assert::assertFits(keySize, keys.getRemain(), "archive block");
+        const char *keyBegin = keys.readBytes(keySize);
+        const char *columnBegin = keys.readBytes(keys.getRemain());
+
+        column = BlockCodec::unshuffle(std::string(columnBegin, raw.data() + raw.size()), periodWidth);
+        keys = BinaryReader(keyBegin, keyBegin + keySize);
+        periods = BinaryReader(column.data(), column.data() + column.size());
+    }
+
+    Moment readMoment() {
+
+        previousMoment += unzigzag(keys.readVarU64()) * momentUnit;
+        return Moment::fromMicrosecondCount(previousMoment);
+    }
+
+    std::uint64_t readIndex() { return keys.readVarU64(); }
+
+    Period readPeriod(int splitIndex) {
+
+        if ((int) previousPeriod.size() <= splitIndex) previousPeriod.resize(splitIndex + 1, 0);
+        if (isMicrosecondPeriod) {
+            auto delta = (std::uint64_t) unzigzag((std::uint64_t) periods.readI64());
+            std::uint64_t bits = previousPeriod[splitIndex] + delta;
+            previousPeriod[splitIndex] = bits;
+            return Period::fromMicrosecondCount((long long) bits);
+        }
+
+        std::uint64_t bits = (std::uint64_t) periods.readI64() ^ previousPeriod[splitIndex];
+        previousPeriod[splitIndex] = bits;
+
+        double secondCount;
+        std::memcpy(&secondCount, &bits, sizeof(secondCount));
+        return Period(secondCount);
+    }
+};
+
+// split blocks of map into compressed data and return their index
+template<class V, class F>
+static std::vector<ArchiveBlock> encodeBlockSet(const MomentMap<V> &map, const F &encodeEntry, std::string *data) {
+
+    std::vector<ArchiveBlock> result;
+    auto it = map.getMap().begin();
+
+    while (it != map.getMap().end()) {
+        ArchiveBlock block{};
+        block.firstMoment = it->first.getMicrosecondCount();
+        BlockEncoder encoder(block.firstMoment);
+
+        for (; it != map.getMap().end() && (int) block.count < CategoryArchive::blockSize; ++it, block.count++) {
+            block.lastMoment = it->first.getMicrosecondCount();
+            encodeEntry(&encoder, it->second);
+        }
+
+        std::string raw = encoder.finish();
+        std::string compressed = BlockCodec::compress(raw);
+        block.offset = data->size();
+        block.rawSize = (std::uint32_t) raw.size();
+        block.compressedSize = (std::uint32_t) compressed.size();
+        block.checksum = Checksum::crc32c(compressed.data(), compressed.size());
+        data->append(compressed);
+        result.push_back(block);
+    }
+
+    return result;
+}
+
+static void writeBlock(BinaryWriter &writer, const ArchiveBlock &block) {
+
+    writer.writeI64(block.firstMoment);
+    writer.writeI64(block.lastMoment);
+    writer.writeU32(block.count);
+    writer.writeI64((std::int64_t) block.offset);
+    writer.writeU32(block.compressedSize);
+    writer.writeU32(block.rawSize);
+    writer.writeU32(block.checksum);
+}
+
+static ArchiveBlock readBlock(BinaryReader &reader, std::int64_t momentUnit) {
+
+    ArchiveBlock block{};
+    block.firstMoment = reader.readI64() * momentUnit;
+    block.lastMoment = reader.readI64() * momentUnit;
+    block.count = reader.readU32();
+    block.offset = (std::uint64_t) reader.readI64();
+    block.compressedSize = reader.readU32();
+    block.rawSize = reader.readU32();
+    block.checksum = reader.readU32();
+    return block;
+}
+
+static void writeBlockSet(BinaryWriter &writer, const std::vector<ArchiveBlock> &blockSet) {
+
+    writer.writeU32((std::uint32_t) blockSet.size());
+    for (const ArchiveBlock &block: blockSet) writeBlock(writer, block);
+}
+
+static std::vector<ArchiveBlock> readBlockSet(BinaryReader &reader, std::int64_t momentUnit) {
+
+    std::uint32_t count = reader.readCount();
+    std::vector<ArchiveBlock> blockSet;
+    blockSet.reserve(count);
+    for (std::uint32_t i = 0; i < count; i++) blockSet.push_back(readBlock(reader, momentUnit));
+    return blockSet;
+}
+
+void CategoryArchive::exportArchive(const std::string &fileName, const SpeedCategory *speedCategory) {
+
+    std::map<std::string, std::uint64_t> templateIndex;
+    speedCategory->getSplitTemplateSet().forEach([&templateIndex](const SplitTemplate &v) {
+        templateIndex.insert({v.getKey(), templateIndex.size()});
+    });
+
+    BinaryWriter headWriter(true);
+    speedCategory->HasName::exportBinary(headWriter, true);
+    speedCategory->getSplitTemplateSet().exportBinary(headWriter, true);
+    speedCategory->getSplitComparisonSet().exportBinary(headWriter, true);
+
+    std::string data = BlockCodec::compress(headWriter.getBody());
+    ArchiveBlock head{};
+    head.rawSize = (std::uint32_t) headWriter.getBody().size();
+    head.compressedSize = (std::uint32_t) data.size();
+    head.checksum = Checksum::crc32c(data.data(), data.size());
+
+    std::vector<ArchiveBlock> performanceBlockSet = encodeBlockSet(
+            speedCategory->getSplitPerformanceSet(), [&templateIndex](BlockEncoder *encoder, const SplitPerformance &v) {
+                encoder->writeMoment(v.getKey());
+                encoder->writeIndex(templateIndex.at(v.getSplitTemplate()->getKey()));
+                for (int i = 0; i < v.getSize(); i++) encoder->writePeriod(i, v.getSet()[i]);
+            }, &data);
+
+    std::vector<ArchiveBlock> practiceBlockSet = encodeBlockSet(
+            speedCategory->getSplitPracticeSet(), [&templateIndex](BlockEncoder *encoder, const SplitPractice &v) {
+                encoder->writeMoment(v.getKey());
+                encoder->writeIndex(templateIndex.at(v.getSplitTemplate()->getKey()));
+                encoder->writeIndex((std::uint64_t) v.getSplitIndex());
+                encoder->writePeriod(v.getSplitIndex(), v.getTime());
+            }, &data);
+
+    BinaryWriter index(true);
+    index.writeBytes(magic, magicCount);
+    index.writeU32(version);
+    writeBlock(index, head);
+    writeBlockSet(index, performanceBlockSet);
+    writeBlockSet(index, practiceBlockSet);
+
+    std::ofstream file(fileName, std::ios::binary);
+    Assert::assertIsOpen(file.is_open(), "archive");
+    file.write(index.getBody().data(), (std::streamsize) index.getBody().size());
+    file.write(data.data(), (std::streamsize) data.size());
+}
+
+CategoryArchive::CategoryArchive(const std::string &fileName) :
+        file(fileName), dataBegin(nullptr), dataEnd(nullptr), head(), fileVersion(version), momentUnit(1),
+        isHeadDecoded(false) {
+
+    Assert::assertIsOpen(file.isOpen(), "archive");
+    BinaryReader reader(file.getBegin(), file.getEnd());
+
+    const char *header = reader.readBytes(magicCount);
+    Assert::assertEqual(std::memcmp(header, magic, magicCount), 0, "archive header");
+    // archives before microsecond version hold moments in seconds and periods in double seconds
+    fileVersion = reader.readU32();
+    if (fileVersion != version) Assert::assertEqual((int) fileVersion, (int) microsecondVersion - 1, "archive version");
+    if (fileVersion < microsecondVersion) momentUnit = Period::microsecondPerSecond;
+
+    head = readBlock(reader, momentUnit);
+    performanceBlockSet = readBlockSet(reader, momentUnit);
+    practiceBlockSet = readBlockSet(reader, momentUnit);
+
+    dataEnd = file.getEnd();
+    dataBegin = dataEnd - reader.getRemain();
+}
+
+const std::vector<const SplitTemplate *> &CategoryArchive::getTemplateOrder() const {
+
+    if (!isHeadDecoded) {
+        decodeHead(&headCategory, &templateOrder);
+        isHeadDecoded = true;
+    }
+
+    return templateOrder;
+}
+
+std::string CategoryArchive::decompressBlock(const ArchiveBlock &block) const {
+
+    auto dataSize = (std::size_t) (dataEnd - dataBegin);
+    Assert::assertFits(block.offset, dataSize, "archive block");
+    Assert::assertFits(block.compressedSize, dataSize - block.offset, "archive block");
+    Assert::assertChecksum(
+            Checksum::crc32c(dataBegin + block.offset, block.compressedSize), block.checksum, "archive block");
+    return BlockCodec::decompress(dataBegin + block.offset, block.compressedSize, block.rawSize);
+}
+
+int CategoryArchive::verify() const {
+
+    auto dataSize = (std::size_t) (dataEnd - dataBegin);
+    int blockCount = 0;
+    auto verifyBlock = [this, dataSize, &blockCount](const ArchiveBlock &block) {
+        Assert::assertFits(block.offset, dataSize, "archive block");
+        Assert::assertFits(block.compressedSize, dataSize - block.offset, "archive block");
+        Assert::assertChecksum(
+                Checksum::crc32c(dataBegin + block.offset, block.compressedSize), block.checksum, "archive block");
+        blockCount++;
+    };
+
+    verifyBlock(head);
+    for (const ArchiveBlock &block: performanceBlockSet) verifyBlock(block);
+    for (const ArchiveBlock &block: practiceBlockSet) verifyBlock(block);
+    return blockCount;
+}
+
+void CategoryArchive::decodeHead(SpeedCategory *result, std::vector<const SplitTemplate *> *order) const {
+
+    std::string raw = decompressBlock(head);
+    BinaryReader reader(raw.data(), raw.data() + raw.size());
+    if (fileVersion < microsecondVersion) reader.setVersion(BinaryWriter::microsecondVersion - 1);
+    reader.setSpeedCategory(result);
+
+    HasName::importBinary(reader, result, true);
+    NamedMap<SplitTemplate>::importBinary(reader, &result->getSplitTemplateSet(), true);
+    NamedMap<SplitComparison>::importBinary(reader, &result->getSplitComparisonSet(), true);
+
+    order->clear();
+    result->getSplitTemplateSet().forEach([order](const SplitTemplate &v) { order->push_back(&v); });
+}
+
+void CategoryArchive::decodePerformanceBlock(const ArchiveBlock &block,
+                                             const std::vector<const SplitTemplate *> &order,
+                                             const std::function<void(SplitPerformance &)> &visitor) const {
+
+    BlockDecoder decoder(decompressBlock(block), block.firstMoment, momentUnit, fileVersion >= microsecondVersion);
+
+    for (std::uint32_t i = 0; i < block.count; i++) {
+        Moment moment = decoder.readMoment();
+        auto index = (int) decoder.readIndex();
+        Assert::assertRange(index, (int) order.size(), "archive template");
+
+        SplitPerformance splitPerformance(moment, order[index]);
+        for (int j = 0; j < splitPerformance.getSize(); j++) splitPerformance.getSet()[j] = decoder.readPeriod(j);
+        visitor(splitPerformance);
+    }
+}
+
+void CategoryArchive::decodePracticeBlock(const ArchiveBlock &block,
+                                          const std::vector<const SplitTemplate *> &order,
+                                          const std::function<void(SplitPractice &)> &visitor) const {
+
+    BlockDecoder decoder(decompressBlock(block), block.firstMoment, momentUnit, fileVersion >= microsecondVersion);
+
+    for (std::uint32_t i = 0; i < block.count; i++) {
+        Moment moment = decoder.readMoment();
+        auto index = (int) decoder.readIndex();
+        Assert::assertRange(index, (int) order.size(), "archive template");
+        auto splitIndex = (int) decoder.readIndex();
+        Assert::assertRange(splitIndex, order[index]->getSize(), "archive split");
+
+        SplitPractice splitPractice(splitIndex, moment, order[index]);
+        splitPractice.getTime() = decoder.readPeriod(splitIndex);
+        visitor(splitPractice);
+    }
+}
+
+const ArchiveBlock *CategoryArchive::findBlock(const std::vector<ArchiveBlock> &blockSet, const Moment &moment) {
+
+    long long microsecondCount = moment.getMicrosecondCount();
+    auto it = std::upper_bound(blockSet.begin(), blockSet.end(), microsecondCount,
+                               [](long long a, const ArchiveBlock &b) { return a < b.firstMoment; });
+    if (it == blockSet.begin()) return nullptr;
+
+    --it;
+    return microsecondCount <= it->lastMoment ? &*it : nullptr;
+}
+
+void CategoryArchive::importArchive(SpeedCategory *result) const {
+
+    // decode every block into staged category, so a failing block leaves result as it was
+    SpeedCategory staged;
+    std::vector<const SplitTemplate *> order;
+    decodeHead(&staged, &order);
+
+    MomentMap<SplitPerformance> &performanceSet = staged.getSplitPerformanceSet();
+    for (const ArchiveBlock &block: performanceBlockSet)
+        decodePerformanceBlock(block, order, [&performanceSet](SplitPerformance &v) {
+            performanceSet.addValue(std::move(v));
+        });
+
+    MomentMap<SplitPractice> &practiceSet = staged.getSplitPracticeSet();
+    for (const ArchiveBlock &block: practiceBlockSet)
+        decodePracticeBlock(block, order, [&practiceSet](SplitPractice &v) { practiceSet.addValue(std::move(v)); });
+
+    result->adopt(staged);
+}
+
+SplitPerformance CategoryArchive::findPerformance(const Moment &moment) const {
+
+    const ArchiveBlock *block = findBlock(performanceBlockSet, moment);
+    Assert::assertFound(block != nullptr, "performance moment");
+
+    SplitPerformance result;
+    bool found = false;
+    decodePerformanceBlock(*block, getTemplateOrder(), [&moment, &result, &found](SplitPerformance &v) {
+        if (v.getKey() != moment) return;
+        result = v;
+        found = true;
+    });
+
+    Assert::assertFound(found, "performance moment");
+    return result;
+}
+
+SplitPractice CategoryArchive::findPractice(const Moment &moment) const {
+
+    const ArchiveBlock *block = findBlock(practiceBlockSet, moment);
+    Assert::assertFound(block != nullptr, "practice moment");
+
+    SplitPractice result;
+    bool found = false;
+    decodePracticeBlock(*block, getTemplateOrder(), [&moment, &result, &found](SplitPractice &v) {
+        if (v.getKey() != moment) return;
+        result = v;
+        found = true;
+    });
+
+    Assert::assertFound(found, "practice moment");
+    return result;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include "MappedFile.hpp"
+#include "Split.hpp"
+
+// index entry of independently compressed block of performances or practices
+class ArchiveBlock {
+
+public:
+
+    // moment range in microseconds and count of entries in block
+    std::int64_t firstMoment;
+    std::int64_t lastMoment;
+    std::uint32_t count;
+
+    // byte range of compressed block after index
+    std::uint64_t offset;
+    std::uint32_t compressedSize;
+    std::uint32_t rawSize;
+
+    // checksum of compressed block
+    std::uint32_t checksum;
+};
+
+// compressed category archive with block index for decoding single performance or practice
+class CategoryArchive {
+
+private:
+
+    // mapped archive file
+    MappedFile file;
+
+    // start of compressed data after index
+    const char *dataBegin;
+    const char *dataEnd;
+
+    // compressed category name, templates and comparisons
+    ArchiveBlock head;
+
+    // blocks in moment order
+    std::vector<ArchiveBlock> performanceBlockSet;
+    std::vector<ArchiveBlock> practiceBlockSet;
+
+    // format version of archive
+    std::uint32_t fileVersion;
+
+    // microseconds per unit of stored moment, a million for archives written in seconds
+    std::int64_t momentUnit;
+
+    // category holding name, templates and comparisons for single lookup, decoded on first use
+    mutable SpeedCategory headCategory;
+    mutable std::vector<const SplitTemplate *> templateOrder;
+    mutable bool isHeadDecoded;
+
+    // templates of head category in index order
+    const std::vector<const SplitTemplate *> &getTemplateOrder() const;
+
+    // decompress block from mapped file
+    std::string decompressBlock(const ArchiveBlock &block) const;
+
+    // decode head into category and list templates in index order
+    void decodeHead(SpeedCategory *result, std::vector<const SplitTemplate *> *order) const;
+
+    // decode every entry of block and pass it to visitor
+    void decodePerformanceBlock(const ArchiveBlock &block, const std::vector<const SplitTemplate *> &order,
+                                const std::function<void(SplitPerformance &)> &visitor) const;
+
+    void decodePracticeBlock(const ArchiveBlock &block, const std::vector<const SplitTemplate *> &order,
+                             const std::function<void(SplitPractice &)> &visitor) const;
+
+    // block whose moment range contains moment or null
+    static const ArchiveBlock *findBlock(const std::vector<ArchiveBlock> &blockSet, const Moment &moment);
+
+public:
+
+    // file header
+    static const char magic[];
+    static const int magicCount;
+    static const std::uint32_t version;
+
+    // first version with moments in microseconds rather than seconds
+    static const std::uint32_t microsecondVersion;
+
+    // entry count of full block
+    static const int blockSize;
+
+    // constructor
+
+    explicit CategoryArchive(const std::string &fileName);
+
+    CategoryArchive(const CategoryArchive &) = delete;
+
+    CategoryArchive &operator=(const CategoryArchive &) = delete;
+
+    // getter
+
+    const SpeedCategory &getHeadCategory() const {
+
+        getTemplateOrder();
+        return headCategory;
+    }
+
+    int getPerformanceBlockCount() const { return (int) performanceBlockSet.size(); }
+
+    int getPracticeBlockCount() const { return (int) practiceBlockSet.size(); }
+
+    // write category to archive
+
+    static void exportArchive(const std::string &fileName, const SpeedCategory *speedCategory);
+
+    // check every block against its checksum without decoding and return block count
+
+    int verify() const;
+
+    // decode all blocks into category
+
+    void importArchive(SpeedCategory *result) const;
+
+    // decode only block containing moment, with template from head category
+
+    SplitPerformance findPerformance(const Moment &moment) const;
+
+    SplitPractice findPractice(const Moment &moment) const;
+};
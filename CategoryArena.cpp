@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <new>
+#include "CategoryArena.hpp"
+
+const std::size_t CategoryArena::firstChunkSize = 1 << 16;
+const std::size_t CategoryArena::maxChunkSize = 1 << 24;
+const std::size_t CategoryArena::alignment = 16;
+const std::size_t CategoryArena::largeSize = 1 << 14;
+
+CategoryArena::CategoryArena() :
+        cursor(nullptr), end(nullptr), nextChunkSize(firstChunkSize), reservedByte(0) {}
+
+CategoryArena::~CategoryArena() {
+
+    for (char *chunk: chunkSet) ::operator delete(chunk);
+}
+
+void CategoryArena::grow(std::size_t size) {
+
+    std::size_t chunkSize = std::max(nextChunkSize, size);
+    cursor = static_cast<char *>(::operator new(chunkSize));
+    end = cursor + chunkSize;
+    chunkSet.push_back(cursor);
+    reservedByte += chunkSize;
+    nextChunkSize = std::min(nextChunkSize * 2, maxChunkSize);
+}
+
+void *CategoryArena::allocate(std::size_t size) {
+
+    size = (size + alignment - 1) / alignment * alignment;
+    if (size > largeSize) return ::operator new(size);
+
+    std::size_t sizeClass = size / alignment;
+    if (sizeClass < freeSet.size() && freeSet[sizeClass]) {
+        void *block = freeSet[sizeClass];
+        freeSet[sizeClass] = *static_cast<void **>(block);
+        return block;
+    }
+
+    if ((std::size_t) (end - cursor) < size) grow(size);
+    void *block = cursor;
+    cursor += size;
+    return block;
+}
+
+void CategoryArena::deallocate(void *pointer, std::size_t size) {
+
+    size = (size + alignment - 1) / alignment * alignment;
+    if (size > largeSize) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    std::size_t sizeClass = size / alignment;
+    if (sizeClass >= freeSet.size()) freeSet.resize(sizeClass + 1, nullptr);
+    *static_cast<void **>(pointer) = freeSet[sizeClass];
+    freeSet[sizeClass] = pointer;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// chunked bump allocator with free list per size class, releasing all chunks at once on destruction
+class CategoryArena {
+
+private:
+
+    // size of first chunk, doubling up to largest chunk
+    static const std::size_t firstChunkSize;
+    static const std::size_t maxChunkSize;
+
+    // granularity and alignment of every allocation
+    static const std::size_t alignment;
+
+    // allocation size above which heap is used directly
+    static const std::size_t largeSize;
+
+    // owned chunks and unused range of latest chunk
+    std::vector<char *> chunkSet;
+    char *cursor;
+    char *end;
+    std::size_t nextChunkSize;
+    std::size_t reservedByte;
+
+    // head of singly linked list of freed blocks per size class
+    std::vector<void *> freeSet;
+
+    // allocate new chunk holding at least size bytes
+    void grow(std::size_t size);
+
+public:
+
+    // constructor
+
+    explicit CategoryArena();
+
+    CategoryArena(const CategoryArena &) = delete;
+
+    CategoryArena &operator=(const CategoryArena &) = delete;
+
+    // destructor
+
+    ~CategoryArena();
+
+    // getter
+
+    int getChunkCount() const { return (int) chunkSet.size(); }
+
+    std::size_t getReservedByte() const { return reservedByte; }
+
+    // memory operation
+
+    void *allocate(std::size_t size);
+
+    void deallocate(void *pointer, std::size_t size);
+};
+
+// allocator sharing arena between rebound copies, with fresh arena for copied containers
+template<class T>
+class ArenaAllocator {
+
+public:
+
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    // arena owned jointly by container and its rebound allocators
+    std::shared_ptr<CategoryArena> arena;
+
+    // constructor
+
+    explicit ArenaAllocator() : arena(std::make_shared<CategoryArena>()) {}
+
+    ArenaAllocator(const ArenaAllocator &a) : arena(a.arena) {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U> &a) : arena(a.arena) {}
+
+    // memory operation
+
+    T *allocate(std::size_t count) { return static_cast<T *>(arena->allocate(count * sizeof(T))); }
+
+    void deallocate(T *pointer, std::size_t count) { arena->deallocate(pointer, count * sizeof(T)); }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    // comparison operator
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U> &a) const { return arena == a.arena; }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U> &a) const { return arena != a.arena; }
+};
@@ -0,0 +1,181 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "CategoryDelta.hpp"
+#include "CategoryJournal.hpp"
+#include "MappedFile.hpp"
+#include "Assertion.hpp"
+
+const char CategoryDelta::magic[] = "SPLD";
+const int CategoryDelta::magicCount = 4;
+const std::uint32_t CategoryDelta::version = 2;
+const std::uint32_t CategoryDelta::microsecondVersion = 2;
+
+const std::uint32_t CategoryDelta::recordTag = 0x41544c44;
+
+// stamp key with next generation and drop its tombstone
+template<class K>
+static void stampPut(const K &key, std::uint64_t generation,
+                     std::map<K, std::uint64_t> *stamp, std::map<K, std::uint64_t> *tombstone) {
+
+    (*stamp)[key] = generation;
+    tombstone->erase(key);
+}
+
+// tombstone key with next generation and drop its stamp
+template<class K>
+static void stampDelete(const K &key, std::uint64_t generation,
+                        std::map<K, std::uint64_t> *stamp, std::map<K, std::uint64_t> *tombstone) {
+
+    stamp->erase(key);
+    (*tombstone)[key] = generation;
+}
+
+CategoryDelta::CategoryDelta() : generation(0), baseGeneration(0) {
+
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    generation = (std::uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+    baseGeneration = generation;
+}
+
+void CategoryDelta::markNew() {
+
+    templateStamp.clear();
+    comparisonStamp.clear();
+    performanceStamp.clear();
+    practiceStamp.clear();
+    templateTombstone.clear();
+    comparisonTombstone.clear();
+    performanceTombstone.clear();
+    practiceTombstone.clear();
+    baseGeneration = ++generation;
+}
+
+void CategoryDelta::markPut(const SplitTemplate &value) {
+
+    stampPut(value.getKey(), ++generation, &templateStamp, &templateTombstone);
+}
+
+void CategoryDelta::markPut(const SplitComparison &value) {
+
+    stampPut(value.getKey(), ++generation, &comparisonStamp, &comparisonTombstone);
+}
+
+void CategoryDelta::markPut(const SplitPerformance &value) {
+
+    stampPut(value.getKey(), ++generation, &performanceStamp, &performanceTombstone);
+}
+
+void CategoryDelta::markPut(const SplitPractice &value) {
+
+    stampPut(value.getKey(), ++generation, &practiceStamp, &practiceTombstone);
+}
+
+void CategoryDelta::markDelete(const SplitTemplate &value) {
+
+    stampDelete(value.getKey(), ++generation, &templateStamp, &templateTombstone);
+}
+
+void CategoryDelta::markDelete(const SplitComparison &value) {
+
+    stampDelete(value.getKey(), ++generation, &comparisonStamp, &comparisonTombstone);
+}
+
+void CategoryDelta::markDelete(const SplitPerformance &value) {
+
+    stampDelete(value.getKey(), ++generation, &performanceStamp, &performanceTombstone);
+}
+
+void CategoryDelta::markDelete(const SplitPractice &value) {
+
+    stampDelete(value.getKey(), ++generation, &practiceStamp, &practiceTombstone);
+}
+
+std::uint64_t CategoryDelta::exportDelta(const std::string &fileName, const SpeedCategory *speedCategory,
+                                         std::uint64_t sinceGeneration) const {
+
+    BinaryWriter writer(true);
+    writer.writeBytes(magic, magicCount);
+    writer.writeU32(version);
+    writer.writeI64((std::int64_t) sinceGeneration);
+    writer.writeI64((std::int64_t) generation);
+
+    writer.beginSection(recordTag);
+    auto writeRecord = [&writer](const std::string &record) { CategoryJournal::writeRecord(writer, record); };
+
+    if (sinceGeneration < baseGeneration) {
+        writeRecord(CategoryJournal::encodeNew(*speedCategory));
+        speedCategory->getSplitTemplateSet().forEach([&writeRecord](const SplitTemplate &v) {
+            writeRecord(CategoryJournal::encodePut(v));
+        });
+        speedCategory->getSplitComparisonSet().forEach([&writeRecord](const SplitComparison &v) {
+            writeRecord(CategoryJournal::encodePut(v));
+        });
+        speedCategory->getSplitPerformanceSet().forEach([&writeRecord](const SplitPerformance &v) {
+            writeRecord(CategoryJournal::encodePut(v));
+        });
+        speedCategory->getSplitPracticeSet().forEach([&writeRecord](const SplitPractice &v) {
+            writeRecord(CategoryJournal::encodePut(v));
+        });
+    } else {
+        for (const auto &it: templateStamp)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodePut(speedCategory->getSplitTemplateSet().getValue(it.first)));
+        for (const auto &it: comparisonStamp)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodePut(speedCategory->getSplitComparisonSet().getValue(it.first)));
+        for (const auto &it: performanceStamp)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodePut(speedCategory->getSplitPerformanceSet().getValue(it.first)));
+        for (const auto &it: practiceStamp)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodePut(speedCategory->getSplitPracticeSet().getValue(it.first)));
+
+        for (const auto &it: practiceTombstone)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodeDelete(CategoryJournal::deletePracticeType, HasMoment(it.first)));
+        for (const auto &it: performanceTombstone)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodeDelete(
+                        CategoryJournal::deletePerformanceType, HasMoment(it.first)));
+        for (const auto &it: comparisonTombstone)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodeDelete(CategoryJournal::deleteComparisonType, HasName(it.first)));
+        for (const auto &it: templateTombstone)
+            if (it.second > sinceGeneration)
+                writeRecord(CategoryJournal::encodeDelete(CategoryJournal::deleteTemplateType, HasName(it.first)));
+    }
+
+    writer.endSection();
+
+    std::ofstream file(fileName, std::ios::binary);
+    Assert::assertIsOpen(file.is_open(), "delta");
+    file.write(writer.getBody().data(), (std::streamsize) writer.getBody().size());
+    return generation;
+}
+
+std::uint64_t CategoryDelta::importDelta(const std::string &fileName, SpeedCategory *speedCategory) {
+
+    MappedFile file(fileName);
+    Assert::assertIsOpen(file.isOpen(), "delta");
+    BinaryReader reader(file.getBegin(), file.getEnd());
+
+    const char *header = reader.readBytes(magicCount);
+    Assert::assertEqual(std::memcmp(header, magic, magicCount), 0, "delta header");
+    // deltas before microsecond version hold records of category files before microsecond version
+    std::uint32_t fileVersion = reader.readU32();
+    if (fileVersion != version) Assert::assertEqual((int) fileVersion, (int) microsecondVersion - 1, "delta version");
+    if (fileVersion < microsecondVersion) reader.setVersion(BinaryWriter::microsecondVersion - 1);
+    reader.readI64();
+    auto toGeneration = (std::uint64_t) reader.readI64();
+
+    BinaryReader section = reader.readSection(recordTag);
+
+    // apply records to copy of category, so a failing record leaves category as it was
+    SpeedCategory staged;
+    speedCategory->copyInto(&staged);
+    int recordCount = 0;
+    Assert::assertComplete(CategoryJournal::applyRecords(section, &staged, &recordCount), "delta records");
+    speedCategory->adopt(staged);
+    return toGeneration;
+}
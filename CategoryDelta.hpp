@@ -0,0 +1,77 @@
+#pragma once
+#include <map>
+#include "Split.hpp"
+
+// generation stamps of category changes for exporting only entries changed since a generation
+class CategoryDelta {
+
+private:
+
+    // generation of latest change, seeded from clock so generations of later sessions are larger
+    std::uint64_t generation;
+
+    // generation at which whole category was last replaced
+    std::uint64_t baseGeneration;
+
+    // generation of latest put of each present entry
+    std::map<Name, std::uint64_t> templateStamp;
+    std::map<Name, std::uint64_t> comparisonStamp;
+    std::map<Moment, std::uint64_t> performanceStamp;
+    std::map<Moment, std::uint64_t> practiceStamp;
+
+    // generation of deletion of each absent entry
+    std::map<Name, std::uint64_t> templateTombstone;
+    std::map<Name, std::uint64_t> comparisonTombstone;
+    std::map<Moment, std::uint64_t> performanceTombstone;
+    std::map<Moment, std::uint64_t> practiceTombstone;
+
+public:
+
+    // file header
+    static const char magic[];
+    static const int magicCount;
+    static const std::uint32_t version;
+
+    // first version with moments in microseconds rather than seconds
+    static const std::uint32_t microsecondVersion;
+
+    // section tag of records
+    static const std::uint32_t recordTag;
+
+    // constructor
+
+    explicit CategoryDelta();
+
+    // getter
+
+    std::uint64_t getGeneration() const { return generation; }
+
+    // stamp change of working category
+
+    void markNew();
+
+    void markPut(const SplitTemplate &value);
+
+    void markPut(const SplitComparison &value);
+
+    void markPut(const SplitPerformance &value);
+
+    void markPut(const SplitPractice &value);
+
+    void markDelete(const SplitTemplate &value);
+
+    void markDelete(const SplitComparison &value);
+
+    void markDelete(const SplitPerformance &value);
+
+    void markDelete(const SplitPractice &value);
+
+    // write journal records of entries changed after generation and return current generation
+
+    std::uint64_t exportDelta(const std::string &fileName, const SpeedCategory *speedCategory,
+                              std::uint64_t sinceGeneration) const;
+
+    // apply journal records of delta file to category and return generation it brings category to
+
+    static std::uint64_t importDelta(const std::string &fileName, SpeedCategory *speedCategory);
+};
@@ -0,0 +1,256 @@
+#include <cstdio>
+#include "CategoryJournal.hpp"
+#include "MappedFile.hpp"
+#include "SafeSplit.hpp"
+
+const std::uint8_t CategoryJournal::newCategoryType = 0;
+const std::uint8_t CategoryJournal::putTemplateType = 1;
+const std::uint8_t CategoryJournal::putComparisonType = 2;
+const std::uint8_t CategoryJournal::putPerformanceType = 3;
+const std::uint8_t CategoryJournal::putPracticeType = 4;
+const std::uint8_t CategoryJournal::deleteTemplateType = 5;
+const std::uint8_t CategoryJournal::deleteComparisonType = 6;
+const std::uint8_t CategoryJournal::deletePerformanceType = 7;
+const std::uint8_t CategoryJournal::deletePracticeType = 8;
+
+const std::string CategoryJournal::journalExtension = ".journal";
+
+const int CategoryJournal::compactThreshold = 4096;
+
+CategoryJournal::CategoryJournal() : recordCount(0), speedCategory(nullptr) {}
+
+void CategoryJournal::open(const std::string &fileName, SpeedCategory *category) {
+
+    close();
+    snapshotName = fileName + SpeedCategory::binaryExtension;
+    journalName = fileName + journalExtension;
+
+    // journal records share format version of snapshot they follow
+    MappedFile snapshot(snapshotName);
+    bool hasSnapshot = snapshot.isOpen();
+    std::uint32_t version = BinaryWriter::version;
+    if (hasSnapshot) {
+        SafeSplit::importCategory(snapshotName, true, category);
+        BinaryReader header(snapshot.getBegin(), snapshot.getEnd());
+        header.readBytes(BinaryWriter::magicCount);
+        version = header.readU32();
+    }
+    bool isClean = replay(category, version);
+
+    speedCategory = category;
+    if (!hasSnapshot || !isClean || version != BinaryWriter::version) return compact();
+
+    journal.open(journalName, std::ios::binary | std::ios::app);
+    Assert::assertIsOpen(journal.is_open(), "journal");
+}
+
+void CategoryJournal::close() {
+
+    if (journal.is_open()) journal.close();
+    speedCategory = nullptr;
+    recordCount = 0;
+}
+
+void CategoryJournal::compact() {
+
+    if (!isOpen()) return;
+    if (journal.is_open()) journal.close();
+
+    std::string tempName = snapshotName + ".tmp";
+    SafeSplit::exportCategory(tempName, true, speedCategory);
+    if (std::rename(tempName.c_str(), snapshotName.c_str()) != 0) {
+        std::remove(snapshotName.c_str());
+        std::rename(tempName.c_str(), snapshotName.c_str());
+    }
+
+    journal.open(journalName, std::ios::binary | std::ios::trunc);
+    Assert::assertIsOpen(journal.is_open(), "journal");
+    recordCount = 0;
+}
+
+void CategoryJournal::append(const std::string &record) {
+
+    BinaryWriter writer;
+    writeRecord(writer, record);
+    journal.write(writer.getBody().data(), (std::streamsize) writer.getBody().size());
+    journal.flush();
+
+    if (++recordCount >= compactThreshold) compact();
+}
+
+bool CategoryJournal::replay(SpeedCategory *category, std::uint32_t version) {
+
+    MappedFile file(journalName);
+    recordCount = 0;
+    if (!file.isOpen()) return true;
+
+    BinaryReader reader(file.getBegin(), file.getEnd());
+    reader.setVersion(version);
+    return applyRecords(reader, category, &recordCount);
+}
+
+bool CategoryJournal::applyRecords(BinaryReader &reader, SpeedCategory *category, int *recordCount) {
+
+    while (reader.getRemain() > 0) {
+
+        if (reader.getRemain() < sizeof(std::uint32_t)) return false;
+        std::uint32_t length = reader.readU32();
+        if (reader.getRemain() < length) return false;
+
+        const char *begin = reader.readBytes(length);
+        BinaryReader record(begin, begin + length);
+        record.setVersion(reader.getVersion());
+        record.setSpeedCategory(category);
+        std::uint8_t type = record.readU8();
+
+        if (type == newCategoryType) {
+            Name name;
+            Name::importBinary(record, &name, true);
+            *category = SpeedCategory(name);
+        } else if (type == putTemplateType) {
+            SplitTemplate value;
+            SplitTemplate::importBinary(record, &value, true);
+            category->getSplitTemplateSet().putValue(value);
+        } else if (type == putComparisonType) {
+            SplitComparison value;
+            SplitComparison::importBinary(record, &value, true);
+            category->getSplitComparisonSet().putValue(value);
+        } else if (type == putPerformanceType) {
+            SplitPerformance value;
+            SplitPerformance::importBinary(record, &value, true);
+            category->getSplitPerformanceSet().putValue(value);
+        } else if (type == putPracticeType) {
+            SplitPractice value;
+            SplitPractice::importBinary(record, &value, true);
+            category->getSplitPracticeSet().putValue(value);
+        } else if (type == deleteTemplateType) {
+            HasName key;
+            HasName::importBinary(record, &key, true);
+            if (category->getSplitTemplateSet().getMap().count(key.getKey()))
+                category->getSplitTemplateSet().delValue(key.getKey());
+        } else if (type == deleteComparisonType) {
+            HasName key;
+            HasName::importBinary(record, &key, true);
+            if (category->getSplitComparisonSet().getMap().count(key.getKey()))
+                category->getSplitComparisonSet().delValue(key.getKey());
+        } else if (type == deletePerformanceType) {
+            HasMoment key;
+            HasMoment::importBinary(record, &key, true);
+            if (category->getSplitPerformanceSet().getMap().count(key.getKey()))
+                category->getSplitPerformanceSet().delValue(key.getKey());
+        } else if (type == deletePracticeType) {
+            HasMoment key;
+            HasMoment::importBinary(record, &key, true);
+            if (category->getSplitPracticeSet().getMap().count(key.getKey()))
+                category->getSplitPracticeSet().delValue(key.getKey());
+        } else {
+            return false;
+        }
+
+        (*recordCount)++;
+    }
+
+    return true;
+}
+
+std::string CategoryJournal::encodeNew(const SpeedCategory &value) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(newCategoryType);
+    value.HasName::exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodePut(const SplitTemplate &value) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(putTemplateType);
+    value.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodePut(const SplitComparison &value) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(putComparisonType);
+    value.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodePut(const SplitPerformance &value) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(putPerformanceType);
+    value.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodePut(const SplitPractice &value) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(putPracticeType);
+    value.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodeDelete(std::uint8_t type, const HasName &key) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(type);
+    key.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+std::string CategoryJournal::encodeDelete(std::uint8_t type, const HasMoment &key) {
+
+    BinaryWriter writer(true);
+    writer.writeU8(type);
+    key.exportBinary(writer, true);
+    return writer.getBody();
+}
+
+void CategoryJournal::writeRecord(BinaryWriter &writer, const std::string &record) {
+
+    writer.writeU32((std::uint32_t) record.size());
+    writer.writeBytes(record.data(), record.size());
+}
+
+void CategoryJournal::recordPut(const SplitTemplate &value) {
+
+    if (isOpen()) append(encodePut(value));
+}
+
+void CategoryJournal::recordPut(const SplitComparison &value) {
+
+    if (isOpen()) append(encodePut(value));
+}
+
+void CategoryJournal::recordPut(const SplitPerformance &value) {
+
+    if (isOpen()) append(encodePut(value));
+}
+
+void CategoryJournal::recordPut(const SplitPractice &value) {
+
+    if (isOpen()) append(encodePut(value));
+}
+
+void CategoryJournal::recordDelete(const SplitTemplate &value) {
+
+    if (isOpen()) append(encodeDelete(deleteTemplateType, value));
+}
+
+void CategoryJournal::recordDelete(const SplitComparison &value) {
+
+    if (isOpen()) append(encodeDelete(deleteComparisonType, value));
+}
+
+void CategoryJournal::recordDelete(const SplitPerformance &value) {
+
+    if (isOpen()) append(encodeDelete(deletePerformanceType, value));
+}
+
+void CategoryJournal::recordDelete(const SplitPractice &value) {
+
+    if (isOpen()) append(encodeDelete(deletePracticeType, value));
+}
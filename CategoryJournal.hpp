@@ -0,0 +1,109 @@
+#pragma once
+#include <fstream>
+#include "Split.hpp"
+
+// append-only journal of category changes on top of binary snapshot
+class CategoryJournal {
+
+private:
+
+    // file names of snapshot and journal
+    std::string snapshotName;
+    std::string journalName;
+
+    // open journal file and count of records since snapshot
+    std::ofstream journal;
+    int recordCount;
+
+    // category written to snapshot on compaction
+    const SpeedCategory *speedCategory;
+
+    // append single encoded record
+    void append(const std::string &record);
+
+    // replay all complete records of snapshot version and return whether journal ended cleanly
+    bool replay(SpeedCategory *category, std::uint32_t version);
+
+public:
+
+    // record type
+    static const std::uint8_t newCategoryType;
+    static const std::uint8_t putTemplateType;
+    static const std::uint8_t putComparisonType;
+    static const std::uint8_t putPerformanceType;
+    static const std::uint8_t putPracticeType;
+    static const std::uint8_t deleteTemplateType;
+    static const std::uint8_t deleteComparisonType;
+    static const std::uint8_t deletePerformanceType;
+    static const std::uint8_t deletePracticeType;
+
+    // file extension of journal
+    static const std::string journalExtension;
+
+    // record count before automatic compaction
+    static const int compactThreshold;
+
+    // constructor
+
+    explicit CategoryJournal();
+
+    // getter
+
+    bool isOpen() const { return speedCategory != nullptr; }
+
+    const std::string &getSnapshotName() const { return snapshotName; }
+
+    int getRecordCount() const { return recordCount; }
+
+    // encode single record
+
+    static std::string encodeNew(const SpeedCategory &value);
+
+    static std::string encodePut(const SplitTemplate &value);
+
+    static std::string encodePut(const SplitComparison &value);
+
+    static std::string encodePut(const SplitPerformance &value);
+
+    static std::string encodePut(const SplitPractice &value);
+
+    static std::string encodeDelete(std::uint8_t type, const HasName &key);
+
+    static std::string encodeDelete(std::uint8_t type, const HasMoment &key);
+
+    // write record with length prefix
+
+    static void writeRecord(BinaryWriter &writer, const std::string &record);
+
+    // apply length prefixed records to category, counting them, and return whether byte range ended cleanly
+
+    static bool applyRecords(BinaryReader &reader, SpeedCategory *category, int *recordCount);
+
+    // load snapshot and journal into category and keep journal open for append
+
+    void open(const std::string &fileName, SpeedCategory *category);
+
+    void close();
+
+    // write category to snapshot and truncate journal
+
+    void compact();
+
+    // append record of changed category
+
+    void recordPut(const SplitTemplate &value);
+
+    void recordPut(const SplitComparison &value);
+
+    void recordPut(const SplitPerformance &value);
+
+    void recordPut(const SplitPractice &value);
+
+    void recordDelete(const SplitTemplate &value);
+
+    void recordDelete(const SplitComparison &value);
+
+    void recordDelete(const SplitPerformance &value);
+
+    void recordDelete(const SplitPractice &value);
+};
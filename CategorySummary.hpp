@@ -0,0 +1,104 @@
+#pragma once
+#include <map>
+#include "Time.hpp"
+
+// running count, best and total of periods
+class PeriodStatistics {
+
+private:
+
+    // statistics of all added periods
+    int count;
+    Period best;
+    Period total;
+
+public:
+
+    // constructor
+
+    explicit PeriodStatistics() : count(0), best(0), total(0) {}
+
+    // add period to statistics
+
+    void add(const Period &time) {
+
+        if (count == 0 || time < best) best = time;
+        total += time;
+        count++;
+    }
+
+    // getter
+
+    int getCount() const { return count; }
+
+    const Period &getBest() const { return best; }
+
+    Period getAverage() const { return count ? total / count : Period(0); }
+
+    // stream operator
+
+    friend std::ostream &operator<<(std::ostream &stream, const PeriodStatistics &a) {
+
+        return stream << a.count << " " << a.best << " " << a.getAverage();
+    }
+};
+
+// summary of category built one value at a time
+class CategorySummary {
+
+private:
+
+    // category name and value counts
+    std::string name;
+    int templateCount;
+    int comparisonCount;
+    int performanceCount;
+    int practiceCount;
+
+    // statistics of performance totals by template and practice times by template split
+    std::map<std::string, PeriodStatistics> performanceByTemplate;
+    std::map<std::pair<std::string, int>, PeriodStatistics> practiceBySplit;
+
+public:
+
+    // constructor
+
+    explicit CategorySummary() : templateCount(0), comparisonCount(0), performanceCount(0), practiceCount(0) {}
+
+    // add value to summary
+
+    void setName(const std::string &newName) { name = newName; }
+
+    void addTemplate(const std::string &templateName) {
+
+        performanceByTemplate[templateName];
+        templateCount++;
+    }
+
+    void addComparison() { comparisonCount++; }
+
+    void addPerformance(const std::string &templateName, const Period &total) {
+
+        performanceByTemplate[templateName].add(total);
+        performanceCount++;
+    }
+
+    void addPractice(const std::string &templateName, int splitIndex, const Period &time) {
+
+        practiceBySplit[{templateName, splitIndex}].add(time);
+        practiceCount++;
+    }
+
+    // stream operator
+
+    friend std::ostream &operator<<(std::ostream &stream, const CategorySummary &a) {
+
+        stream << a.name << " " << a.templateCount << " " << a.comparisonCount << " " <<
+               a.performanceCount << " " << a.practiceCount << std::endl;
+        for (const auto &it: a.performanceByTemplate)
+            stream << "TEMPLATE " << it.first << " " << it.second << std::endl;
+        for (const auto &it: a.practiceBySplit)
+            stream << "PRACTICE " << it.first.first << " " << it.first.second << " " << it.second << std::endl;
+        return stream;
+    }
+};
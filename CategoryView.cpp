@@ -0,0 +1,80 @@
+#include "CategoryView.hpp"
+#include "Assertion.hpp"
+
+Period IntervalView::getAt(int index) const {
+
+    BinaryReader reader(data + sizeof(long long) * index, data + sizeof(long long) * (index + 1));
+    reader.setVersion(version);
+    Period result;
+    Period::importBinary(reader, &result, true);
+    return result;
+}
+
+Period IntervalView::sum() const {
+
+    Period result(0);
+    for (int i = 0; i < size; i++) result += getAt(i);
+    return result;
+}
+
+std::ostream &operator<<(std::ostream &stream, const IntervalView &a) {
+
+    for (int i = 0; i < a.size; i++) stream << a.getAt(i) << " ";
+    return stream;
+}
+
+CategoryView::CategoryView(const std::string &fileName) : file(fileName) {
+
+    Assert::assertIsOpen(file.isOpen(), "category");
+    BinaryReader reader(file.getBegin(), file.getEnd());
+    reader.readHeader(&nameTable);
+    templateByName.assign(nameTable.size(), -1);
+
+    BinaryReader categorySection = reader.readSection(SpeedCategory::categoryTag);
+    name = categorySection.readName();
+
+    BinaryReader templateSection = reader.readSection(SpeedCategory::templateTag);
+    templateSet.resize(templateSection.readCount());
+    for (TemplateView &view: templateSet) {
+        std::uint32_t nameIndex = templateSection.readU32();
+        Assert::assertRange((int) nameIndex, (int) nameTable.size(), "category file name");
+        templateByName[nameIndex] = (int) (&view - templateSet.data());
+        view.name = nameTable[nameIndex];
+        view.splitNameSet.resize(templateSection.readCount());
+        for (NameView &splitName: view.splitNameSet) splitName = templateSection.readName();
+    }
+
+    BinaryReader comparisonSection = reader.readSection(SpeedCategory::comparisonTag);
+    comparisonSet.resize(comparisonSection.readCount());
+    for (ComparisonView &view: comparisonSet) {
+        view.name = comparisonSection.readName();
+        view.templateIndex = nextTemplateIndex(comparisonSection);
+        int size = (int) templateSet[view.templateIndex].splitNameSet.size();
+        view.splitSet = IntervalView(comparisonSection.readBytes(sizeof(long long) * size), size, reader.getVersion());
+    }
+
+    BinaryReader performanceSection = reader.readSection(SpeedCategory::performanceTag);
+    performanceSet.resize(performanceSection.readCount());
+    for (PerformanceView &view: performanceSet) {
+        Moment::importBinary(performanceSection, &view.moment, true);
+        view.templateIndex = nextTemplateIndex(performanceSection);
+        int size = (int) templateSet[view.templateIndex].splitNameSet.size();
+        view.splitSet = IntervalView(performanceSection.readBytes(sizeof(long long) * size), size, reader.getVersion());
+    }
+
+    BinaryReader practiceSection = reader.readSection(SpeedCategory::practiceTag);
+    practiceSet.resize(practiceSection.readCount());
+    for (PracticeView &view: practiceSet) {
+        Moment::importBinary(practiceSection, &view.moment, true);
+        view.templateIndex = nextTemplateIndex(practiceSection);
+        view.splitIndex = practiceSection.readI32();
+        Period::importBinary(practiceSection, &view.time, true);
+    }
+}
+
+int CategoryView::nextTemplateIndex(BinaryReader &reader) const {
+
+    std::uint32_t nameIndex = reader.readU32();
+    Assert::assertRange((int) nameIndex, (int) nameTable.size(), "category file name");
+    return Assert::assertRange(templateByName[nameIndex], (int) templateSet.size(), "category file template");
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "MappedFile.hpp"
+#include "Split.hpp"
+
+// view of split times inside mapped binary file
+class IntervalView {
+
+private:
+
+    // byte range of fixed width periods
+    const char *data;
+    int size;
+
+    // format version of file periods were written in
+    std::uint32_t version;
+
+public:
+
+    // constructor
+
+    explicit IntervalView() : data(nullptr), size(0), version(0) {}
+
+    explicit IntervalView(const char *data, int size, std::uint32_t version) :
+            data(data), size(size), version(version) {}
+
+    // getter
+
+    int getSize() const { return size; }
+
+    Period getAt(int index) const;
+
+    // summation
+
+    Period sum() const;
+
+    // stream operator
+
+    friend std::ostream &operator<<(std::ostream &stream, const IntervalView &a);
+};
+
+// view of split template inside mapped binary file
+class TemplateView {
+
+public:
+
+    // name of template and its splits
+    NameView name;
+    std::vector<NameView> splitNameSet;
+};
+
+// view of split comparison inside mapped binary file
+class ComparisonView {
+
+public:
+
+    // name and index of relevant template
+    NameView name;
+    int templateIndex;
+
+    // split times
+    IntervalView splitSet;
+};
+
+// view of split performance inside mapped binary file
+class PerformanceView {
+
+public:
+
+    // moment and index of relevant template
+    Moment moment;
+    int templateIndex;
+
+    // split times
+    IntervalView splitSet;
+};
+
+// view of split practice inside mapped binary file
+class PracticeView {
+
+public:
+
+    // moment and index of relevant template
+    Moment moment;
+    int templateIndex;
+
+    // index of relevant split and split time
+    int splitIndex;
+    Period time;
+};
+
+// read-only view of binary category file without copying names or split times
+class CategoryView {
+
+private:
+
+    // mapped file backing all views
+    MappedFile file;
+
+    // views into mapped file
+    std::vector<NameView> nameTable;
+    NameView name;
+    std::vector<TemplateView> templateSet;
+    std::vector<ComparisonView> comparisonSet;
+    std::vector<PerformanceView> performanceSet;
+    std::vector<PracticeView> practiceSet;
+
+    // template index by name table index
+    std::vector<int> templateByName;
+
+    // index of template referenced by next name in section
+    int nextTemplateIndex(BinaryReader &reader) const;
+
+public:
+
+    // constructor
+
+    explicit CategoryView() = default;
+
+    explicit CategoryView(const std::string &fileName);
+
+    // getter
+
+    const NameView &getName() const { return name; }
+
+    const std::vector<TemplateView> &getTemplateSet() const { return templateSet; }
+
+    const std::vector<ComparisonView> &getComparisonSet() const { return comparisonSet; }
+
+    const std::vector<PerformanceView> &getPerformanceSet() const { return performanceSet; }
+
+    const std::vector<PracticeView> &getPracticeSet() const { return practiceSet; }
+};
@@ -0,0 +1,87 @@
+#include <cstring>
+#include "Checksum.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define CHECKSUM_HAS_SSE42 1
+#endif
+
+// reflected crc32c polynomial
+static const std::uint32_t polynomial = 0x82f63b78;
+
+// lookup tables for eight bytes per step in software fallback
+class SliceTable {
+
+public:
+
+    std::uint32_t table[8][256];
+
+    explicit SliceTable() {
+
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t crc = i;
+            for (int j = 0; j < 8; j++) crc = (crc >> 1) ^ (polynomial & (0 - (crc & 1)));
+            table[0][i] = crc;
+        }
+        for (std::uint32_t i = 0; i < 256; i++)
+            for (int k = 1; k < 8; k++) table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+    }
+};
+
+static const SliceTable sliceTable;
+
+static std::uint32_t crc32cSoftware(const unsigned char *data, std::size_t size, std::uint32_t crc) {
+
+    const std::uint32_t (*t)[256] = sliceTable.table;
+
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint32_t low = crc ^ ((std::uint32_t) data[0] | (std::uint32_t) data[1] << 8 |
+                                   (std::uint32_t) data[2] << 16 | (std::uint32_t) data[3] << 24);
+        crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+              t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+    }
+
+    for (; size > 0; data++, size--) crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+    return crc;
+}
+
+#ifdef CHECKSUM_HAS_SSE42
+
+__attribute__((target("sse4.2")))
+static std::uint32_t crc32cHardware(const unsigned char *data, std::size_t size, std::uint32_t crc) {
+
+#if defined(__x86_64__)
+    std::uint64_t wide = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+    }
+    crc = (std::uint32_t) wide;
+#endif
+
+    for (; size > 0; data++, size--) crc = _mm_crc32_u8(crc, *data);
+    return crc;
+}
+
+static bool detectHardware() {
+
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+static const bool hasHardware = detectHardware();
+
+#endif
+
+std::uint32_t Checksum::crc32c(const char *data, std::size_t size, std::uint32_t previous) {
+
+    auto bytes = (const unsigned char *) data;
+    std::uint32_t crc = ~previous;
+
+#ifdef CHECKSUM_HAS_SSE42
+    if (hasHardware) return ~crc32cHardware(bytes, size, crc);
+#endif
+
+    return ~crc32cSoftware(bytes, size, crc);
+}
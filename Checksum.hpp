@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// crc32c of byte ranges using sse4.2 instruction when the processor has it
+namespace Checksum {
+
+    // checksum of byte range continuing from checksum of preceding bytes
+    std::uint32_t crc32c(const char *data, std::size_t size, std::uint32_t previous = 0);
+}
@@ -0,0 +1,56 @@
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include "Clock.hpp"
+
+// wall clock moment paired with steady clock reading taken at same instant
+class ClockAnchor {
+
+public:
+
+    long long microsecondCount;
+    std::chrono::steady_clock::time_point steady;
+
+    explicit ClockAnchor() : steady(std::chrono::steady_clock::now()) {
+
+        auto wall = std::chrono::system_clock::now().time_since_epoch();
+        microsecondCount = Moment::epoch.getMicrosecondCount() +
+                           std::chrono::duration_cast<std::chrono::microseconds>(wall).count();
+    }
+};
+
+// anchor taken on first use, after static moments it depends on are initialized
+static const ClockAnchor &anchor() {
+
+    static const ClockAnchor result;
+    return result;
+}
+
+// last key issued, shared by all threads
+static std::atomic<long long> lastKey(0);
+
+Moment Clock::now() {
+
+    const ClockAnchor &start = anchor();
+    auto elapsed = std::chrono::steady_clock::now() - start.steady;
+    return Moment::fromMicrosecondCount(
+            start.microsecondCount + std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+Moment Clock::nextKey() {
+
+    return nextKey(Moment::fromMicrosecondCount(LLONG_MIN));
+}
+
+Moment Clock::nextKey(const Moment &floor) {
+
+    long long candidate = now().getMicrosecondCount();
+    long long floorCount = floor.getMicrosecondCount();
+    if (candidate <= floorCount && floorCount < LLONG_MAX) candidate = floorCount + 1;
+    long long last = lastKey.load(std::memory_order_relaxed);
+    long long key;
+    do {
+        key = candidate > last ? candidate : last + 1;
+    } while (!lastKey.compare_exchange_weak(last, key, std::memory_order_relaxed));
+    return Moment::fromMicrosecondCount(key);
+}
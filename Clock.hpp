@@ -0,0 +1,15 @@
+#pragma once
+#include "Time.hpp"
+
+// monotonic microsecond clock anchored once to wall clock, for timing moments of live runs
+namespace Clock {
+
+    // wall clock at first use plus steady time elapsed since, so moments never go backwards
+    Moment now();
+
+    // current moment, advanced past last key so keys taken within one microsecond stay distinct
+    Moment nextKey();
+
+    // as above, also advanced past floor such as latest moment already in map
+    Moment nextKey(const Moment &floor);
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// sorted vector with ordered map interface, appending in constant time when keys arrive in order
+template<class K, class V>
+class FlatMap {
+
+public:
+
+    typedef std::pair<K, V> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+private:
+
+    // entries in increasing key order
+    std::vector<value_type> entrySet;
+
+    // first entry with key not less than key
+    iterator lowerBound(const K &key) {
+
+        return std::lower_bound(entrySet.begin(), entrySet.end(), key,
+                                [](const value_type &a, const K &b) { return a.first < b; });
+    }
+
+    const_iterator lowerBound(const K &key) const {
+
+        return std::lower_bound(entrySet.begin(), entrySet.end(), key,
+                                [](const value_type &a, const K &b) { return a.first < b; });
+    }
+
+public:
+
+    // getter
+
+    std::size_t size() const { return entrySet.size(); }
+
+    bool empty() const { return entrySet.empty(); }
+
+    std::size_t capacity() const { return entrySet.capacity(); }
+
+    // iterator
+
+    iterator begin() { return entrySet.begin(); }
+
+    iterator end() { return entrySet.end(); }
+
+    const_iterator begin() const { return entrySet.begin(); }
+
+    const_iterator end() const { return entrySet.end(); }
+
+    // search
+
+    iterator find(const K &key) {
+
+        iterator it = lowerBound(key);
+        return it != entrySet.end() && !(key < it->first) ? it : entrySet.end();
+    }
+
+    const_iterator find(const K &key) const {
+
+        const_iterator it = lowerBound(key);
+        return it != entrySet.end() && !(key < it->first) ? it : entrySet.end();
+    }
+
+    std::size_t count(const K &key) const { return find(key) != entrySet.end(); }
+
+    // first entry with key not less than key, or greater than key
+
+    const_iterator lower_bound(const K &key) const { return lowerBound(key); }
+
+    const_iterator upper_bound(const K &key) const {
+
+        return std::upper_bound(entrySet.begin(), entrySet.end(), key,
+                                [](const K &a, const value_type &b) { return a < b.first; });
+    }
+
+    // insert unless key exists, appending without search when key follows last key
+
+    template<class... A>
+    std::pair<iterator, bool> emplace(const K &key, A &&... args) {
+
+        if (entrySet.empty() || entrySet.back().first < key) {
+            entrySet.emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<A>(args)...));
+            return {entrySet.end() - 1, true};
+        }
+
+        iterator it = lowerBound(key);
+        if (!(key < it->first)) return {it, false};
+        std::ptrdiff_t index = it - entrySet.begin();
+        entrySet.emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<A>(args)...));
+        return {entrySet.begin() + index, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &entry) { return emplace(entry.first, entry.second); }
+
+    // erase
+
+    iterator erase(iterator it) { return entrySet.erase(it); }
+
+    std::size_t erase(const K &key) {
+
+        iterator it = find(key);
+        if (it == entrySet.end()) return 0;
+        entrySet.erase(it);
+        return 1;
+    }
+
+    void clear() { entrySet.clear(); }
+
+    void reserve(std::size_t size) { entrySet.reserve(size); }
+};
@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cmath>
+#include "IntervalKernel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define INTERVAL_KERNEL_HAS_X86 1
+#endif
+
+// instruction set of kernels
+static const int scalarLevel = 0;
+static const int sse2Level = 1;
+static const int avx2Level = 2;
+
+// scalar kernels, also finishing tails of vector kernels
+
+static void addScalar(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    for (std::size_t i = 0; i < size; i++) result[i] = a[i] + b[i];
+}
+
+static void subtractScalar(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    for (std::size_t i = 0; i < size; i++) result[i] = a[i] - b[i];
+}
+
+static void multiplyScalar(const long long *a, double factor, long long *result, std::size_t size) {
+
+    for (std::size_t i = 0; i < size; i++) result[i] = std::llrint((double) a[i] * factor);
+}
+
+static void divideScalar(const long long *a, double divisor, long long *result, std::size_t size) {
+
+    for (std::size_t i = 0; i < size; i++) result[i] = std::llrint((double) a[i] / divisor);
+}
+
+static long long sumScalar(const long long *a, std::size_t size) {
+
+    long long result = 0;
+    for (std::size_t i = 0; i < size; i++) result += a[i];
+    return result;
+}
+
+static long long minScalar(const long long *a, std::size_t size) {
+
+    long long result = a[0];
+    for (std::size_t i = 1; i < size; i++) result = a[i] < result ? a[i] : result;
+    return result;
+}
+
+static long long maxScalar(const long long *a, std::size_t size) {
+
+    long long result = a[0];
+    for (std::size_t i = 1; i < size; i++) result = a[i] > result ? a[i] : result;
+    return result;
+}
+
+static void prefixSumScalar(const long long *a, long long *result, std::size_t size, long long carry) {
+
+    for (std::size_t i = 0; i < size; i++) result[i] = carry += a[i];
+}
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+
+// sse2 kernels, two counts per step
+
+__attribute__((target("sse2")))
+static void addSse2(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *) (b + i));
+        _mm_storeu_si128((__m128i *) (result + i), _mm_add_epi64(x, y));
+    }
+    addScalar(a + i, b + i, result + i, size - i);
+}
+
+__attribute__((target("sse2")))
+static void subtractSse2(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *) (b + i));
+        _mm_storeu_si128((__m128i *) (result + i), _mm_sub_epi64(x, y));
+    }
+    subtractScalar(a + i, b + i, result + i, size - i);
+}
+
+__attribute__((target("sse2")))
+static long long sumSse2(const long long *a, std::size_t size) {
+
+    __m128i total = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2) total = _mm_add_epi64(total, _mm_loadu_si128((const __m128i *) (a + i)));
+
+    long long lane[2];
+    _mm_storeu_si128((__m128i *) lane, total);
+    return lane[0] + lane[1] + sumScalar(a + i, size - i);
+}
+
+// avx2 kernels, four counts per step
+
+// exact conversion between count and double below 2 to the 51 in magnitude, rounding double to nearest
+static const long long magicBits = 0x4338000000000000LL;
+static const double magicDouble = 6755399441055744.0;
+
+__attribute__((target("avx2")))
+static inline __m256d toDouble(__m256i x) {
+
+    __m256i bits = _mm256_add_epi64(x, _mm256_set1_epi64x(magicBits));
+    return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(magicDouble));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i toCount(__m256d x) {
+
+    __m256i bits = _mm256_castpd_si256(_mm256_add_pd(x, _mm256_set1_pd(magicDouble)));
+    return _mm256_sub_epi64(bits, _mm256_set1_epi64x(magicBits));
+}
+
+__attribute__((target("avx2")))
+static void addAvx2(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (b + i));
+        _mm256_storeu_si256((__m256i *) (result + i), _mm256_add_epi64(x, y));
+    }
+    addScalar(a + i, b + i, result + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static void subtractAvx2(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (b + i));
+        _mm256_storeu_si256((__m256i *) (result + i), _mm256_sub_epi64(x, y));
+    }
+    subtractScalar(a + i, b + i, result + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static void multiplyAvx2(const long long *a, double factor, long long *result, std::size_t size) {
+
+    __m256d scale = _mm256_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256d x = toDouble(_mm256_loadu_si256((const __m256i *) (a + i)));
+        _mm256_storeu_si256((__m256i *) (result + i), toCount(_mm256_mul_pd(x, scale)));
+    }
+    multiplyScalar(a + i, factor, result + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static void divideAvx2(const long long *a, double divisor, long long *result, std::size_t size) {
+
+    __m256d scale = _mm256_set1_pd(divisor);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256d x = toDouble(_mm256_loadu_si256((const __m256i *) (a + i)));
+        _mm256_storeu_si256((__m256i *) (result + i), toCount(_mm256_div_pd(x, scale)));
+    }
+    divideScalar(a + i, divisor, result + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static long long sumAvx2(const long long *a, std::size_t size) {
+
+    // two accumulators so consecutive additions do not wait on each other
+    __m256i total0 = _mm256_setzero_si256();
+    __m256i total1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        total0 = _mm256_add_epi64(total0, _mm256_loadu_si256((const __m256i *) (a + i)));
+        total1 = _mm256_add_epi64(total1, _mm256_loadu_si256((const __m256i *) (a + i + 4)));
+    }
+
+    long long lane[4];
+    _mm256_storeu_si256((__m256i *) lane, _mm256_add_epi64(total0, total1));
+    return lane[0] + lane[1] + lane[2] + lane[3] + sumScalar(a + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static long long minAvx2(const long long *a, std::size_t size) {
+
+    if (size < 4) return minScalar(a, size);
+
+    __m256i best = _mm256_loadu_si256((const __m256i *) a);
+    std::size_t i = 4;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        best = _mm256_blendv_epi8(best, x, _mm256_cmpgt_epi64(best, x));
+    }
+
+    long long lane[4];
+    _mm256_storeu_si256((__m256i *) lane, best);
+    long long result = minScalar(lane, 4);
+    return i < size ? std::min(result, minScalar(a + i, size - i)) : result;
+}
+
+__attribute__((target("avx2")))
+static long long maxAvx2(const long long *a, std::size_t size) {
+
+    if (size < 4) return maxScalar(a, size);
+
+    __m256i best = _mm256_loadu_si256((const __m256i *) a);
+    std::size_t i = 4;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        best = _mm256_blendv_epi8(best, x, _mm256_cmpgt_epi64(x, best));
+    }
+
+    long long lane[4];
+    _mm256_storeu_si256((__m256i *) lane, best);
+    long long result = maxScalar(lane, 4);
+    return i < size ? std::max(result, maxScalar(a + i, size - i)) : result;
+}
+
+__attribute__((target("avx2")))
+static void prefixSumAvx2(const long long *a, long long *result, std::size_t size) {
+
+    __m256i carry = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        // scan within each half, then add last of lower half to upper half
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+        __m256i lower = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 1, 1, 1));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_setzero_si256(), lower, 0xf0));
+        x = _mm256_add_epi64(x, carry);
+        _mm256_storeu_si256((__m256i *) (result + i), x);
+        carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    prefixSumScalar(a + i, result + i, size - i, i > 0 ? result[i - 1] : 0);
+}
+
+static int detectLevel() {
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return avx2Level;
+    if (__builtin_cpu_supports("sse2")) return sse2Level;
+    return scalarLevel;
+}
+
+static const int level = detectLevel();
+
+#else
+
+static const int level = scalarLevel;
+
+#endif
+
+const char *IntervalKernel::getLevel() {
+
+    return level == avx2Level ? "avx2" : level == sse2Level ? "sse2" : "scalar";
+}
+
+void IntervalKernel::add(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return addAvx2(a, b, result, size);
+    if (level == sse2Level) return addSse2(a, b, result, size);
+#endif
+
+    addScalar(a, b, result, size);
+}
+
+void IntervalKernel::subtract(const long long *a, const long long *b, long long *result, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return subtractAvx2(a, b, result, size);
+    if (level == sse2Level) return subtractSse2(a, b, result, size);
+#endif
+
+    subtractScalar(a, b, result, size);
+}
+
+void IntervalKernel::multiply(const long long *a, double factor, long long *result, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return multiplyAvx2(a, factor, result, size);
+#endif
+
+    multiplyScalar(a, factor, result, size);
+}
+
+void IntervalKernel::divide(const long long *a, double divisor, long long *result, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return divideAvx2(a, divisor, result, size);
+#endif
+
+    divideScalar(a, divisor, result, size);
+}
+
+long long IntervalKernel::sum(const long long *a, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return sumAvx2(a, size);
+    if (level == sse2Level) return sumSse2(a, size);
+#endif
+
+    return sumScalar(a, size);
+}
+
+long long IntervalKernel::min(const long long *a, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return minAvx2(a, size);
+#endif
+
+    return minScalar(a, size);
+}
+
+long long IntervalKernel::max(const long long *a, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return maxAvx2(a, size);
+#endif
+
+    return maxScalar(a, size);
+}
+
+void IntervalKernel::prefixSum(const long long *a, long long *result, std::size_t size) {
+
+#ifdef INTERVAL_KERNEL_HAS_X86
+    if (level == avx2Level) return prefixSumAvx2(a, result, size);
+#endif
+
+    prefixSumScalar(a, result, size, 0);
+}
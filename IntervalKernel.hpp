@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+// elementwise and reducing kernels over microsecond counts using avx2 or sse2 when the processor has it
+namespace IntervalKernel {
+
+    // name of instruction set selected at startup
+    const char *getLevel();
+
+    // elementwise result of two ranges or of range and factor
+
+    void add(const long long *a, const long long *b, long long *result, std::size_t size);
+
+    void subtract(const long long *a, const long long *b, long long *result, std::size_t size);
+
+    // rounded to nearest, for counts and results below 2 to the 51 microseconds
+
+    void multiply(const long long *a, double factor, long long *result, std::size_t size);
+
+    void divide(const long long *a, double divisor, long long *result, std::size_t size);
+
+    // reduction of non-empty range
+
+    long long sum(const long long *a, std::size_t size);
+
+    long long min(const long long *a, std::size_t size);
+
+    long long max(const long long *a, std::size_t size);
+
+    // inclusive running sum
+    void prefixSum(const long long *a, long long *result, std::size_t size);
+}
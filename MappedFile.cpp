@@ -0,0 +1,104 @@
+#include <utility>
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+
+MappedFile::MappedFile(const std::string &fileName) : MappedFile() {
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        release();
+        return;
+    }
+    size = (std::size_t) fileSize.QuadPart;
+    if (size == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        release();
+        return;
+    }
+    mappingHandle = mapping;
+
+    data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        release();
+        return;
+    }
+#else
+    int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0) return;
+    fileHandle = reinterpret_cast<void *>((std::ptrdiff_t) file + 1);
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0) {
+        release();
+        return;
+    }
+    size = (std::size_t) fileStat.st_size;
+    if (size == 0) return;
+
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    if (mapping == MAP_FAILED) {
+        release();
+        return;
+    }
+    mappingHandle = mapping;
+    data = static_cast<const char *>(mapping);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile &&a) noexcept:
+        data(a.data), size(a.size), fileHandle(a.fileHandle), mappingHandle(a.mappingHandle) {
+
+    a.data = nullptr;
+    a.size = 0;
+    a.fileHandle = nullptr;
+    a.mappingHandle = nullptr;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile &MappedFile::operator=(MappedFile &&a) noexcept {
+
+    if (this != &a) {
+        release();
+        std::swap(data, a.data);
+        std::swap(size, a.size);
+        std::swap(fileHandle, a.fileHandle);
+        std::swap(mappingHandle, a.mappingHandle);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+
+#ifdef _WIN32
+    if (data != nullptr) UnmapViewOfFile(data);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != nullptr) CloseHandle(fileHandle);
+#else
+    if (mappingHandle != nullptr) munmap(mappingHandle, size);
+    if (fileHandle != nullptr) close((int) (reinterpret_cast<std::ptrdiff_t>(fileHandle) - 1));
+#endif
+
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
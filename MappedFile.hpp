@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// read-only memory mapping of file on local drive
+class MappedFile {
+
+private:
+
+    // mapped byte range
+    const char *data;
+    std::size_t size;
+
+    // platform handles of open mapping
+    void *fileHandle;
+    void *mappingHandle;
+
+    // unmap and close handles
+    void release();
+
+public:
+
+    // constructor
+
+    explicit MappedFile();
+
+    explicit MappedFile(const std::string &fileName);
+
+    MappedFile(const MappedFile &a) = delete;
+
+    MappedFile(MappedFile &&a) noexcept;
+
+    ~MappedFile();
+
+    // getter
+
+    bool isOpen() const { return fileHandle != nullptr; }
+
+    const char *getBegin() const { return data; }
+
+    const char *getEnd() const { return data + size; }
+
+    std::size_t getSize() const { return size; }
+
+    // assignment operator
+
+    MappedFile &operator=(const MappedFile &a) = delete;
+
+    MappedFile &operator=(MappedFile &&a) noexcept;
+};
@@ -0,0 +1,54 @@
+#include <cstring>
+#include "NameTable.hpp"
+
+std::uint32_t NameTable::hash(const char *data, std::size_t size) {
+
+    // fnv-1a
+    std::uint32_t result = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) result = (result ^ (unsigned char) data[i]) * 16777619u;
+    return result;
+}
+
+std::size_t NameTable::findSlot(const char *data, std::size_t size) const {
+
+    std::size_t mask = slotSet.size() - 1;
+    std::size_t slot = hash(data, size) & mask;
+    while (slotSet[slot] != 0) {
+        const std::string &name = nameSet[slotSet[slot] - 1];
+        if (name.size() == size && std::memcmp(name.data(), data, size) == 0) return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void NameTable::grow() {
+
+    slotSet.assign(slotSet.empty() ? 16 : slotSet.size() * 2, 0);
+    for (std::size_t id = 0; id < nameSet.size(); id++)
+        slotSet[findSlot(nameSet[id].data(), nameSet[id].size())] = (std::uint32_t) id + 1;
+}
+
+int NameTable::find(const char *data, std::size_t size) const {
+
+    if (slotSet.empty()) return -1;
+    return (int) slotSet[findSlot(data, size)] - 1;
+}
+
+int NameTable::intern(const char *data, std::size_t size) {
+
+    // keep load factor at most one half
+    if ((nameSet.size() + 1) * 2 > slotSet.size()) grow();
+
+    std::size_t slot = findSlot(data, size);
+    if (slotSet[slot] == 0) {
+        nameSet.emplace_back(data, size);
+        slotSet[slot] = (std::uint32_t) nameSet.size();
+    }
+    return (int) slotSet[slot] - 1;
+}
+
+void NameTable::clear() {
+
+    nameSet.clear();
+    slotSet.clear();
+}
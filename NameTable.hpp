@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// interner assigning dense integer id to each distinct name, searchable by byte range without copying
+class NameTable {
+
+private:
+
+    // interned names by id
+    std::vector<std::string> nameSet;
+
+    // open addressing slots holding id + 1, or 0 when empty
+    std::vector<std::uint32_t> slotSet;
+
+    // hash of byte range
+    static std::uint32_t hash(const char *data, std::size_t size);
+
+    // slot holding name or empty slot where it belongs
+    std::size_t findSlot(const char *data, std::size_t size) const;
+
+    // double slot count and reinsert all names
+    void grow();
+
+public:
+
+    // constructor
+
+    explicit NameTable() {}
+
+    // getter
+
+    int getSize() const { return (int) nameSet.size(); }
+
+    const std::string &getName(int id) const { return nameSet[id]; }
+
+    // id of name, or -1 if not interned
+
+    int find(const char *data, std::size_t size) const;
+
+    int find(const std::string &name) const { return find(name.data(), name.size()); }
+
+    // id of name, interning it if new
+
+    int intern(const char *data, std::size_t size);
+
+    int intern(const std::string &name) { return intern(name.data(), name.size()); }
+
+    void clear();
+};
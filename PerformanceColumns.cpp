@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+#include "PerformanceColumns.hpp"
+#include "IntervalKernel.hpp"
+#include "Split.hpp"
+
+std::size_t PerformanceColumn::findRow(long long microsecondCount) const {
+
+    return std::lower_bound(momentColumn.begin(), momentColumn.end(), microsecondCount) - momentColumn.begin();
+}
+
+void PerformanceColumn::putValue(const SplitPerformance &value) {
+
+    long long microsecondCount = value.getKey().getMicrosecondCount();
+    std::size_t row = findRow(microsecondCount);
+    bool exists = row < momentColumn.size() && momentColumn[row] == microsecondCount;
+
+    if (!exists) momentColumn.insert(momentColumn.begin() + row, microsecondCount);
+    for (int i = 0; i < getSplitCount(); i++) {
+        long long time = value.getSet()[i].microsecondInAllCount();
+        std::vector<long long> &column = splitColumn[i];
+        if (exists) column[row] = time;
+        else column.insert(column.begin() + row, time);
+    }
+}
+
+bool PerformanceColumn::delValue(const Moment &moment) {
+
+    long long microsecondCount = moment.getMicrosecondCount();
+    std::size_t row = findRow(microsecondCount);
+    if (row == momentColumn.size() || momentColumn[row] != microsecondCount) return false;
+
+    momentColumn.erase(momentColumn.begin() + row);
+    for (std::vector<long long> &column: splitColumn) column.erase(column.begin() + row);
+    return true;
+}
+
+Period PerformanceColumn::best(int index) const {
+
+    const std::vector<long long> &column = splitColumn[index];
+    if (column.empty()) return Period(0);
+
+    return Period::fromMicrosecondCount(IntervalKernel::min(column.data(), column.size()));
+}
+
+Period PerformanceColumn::average(int index) const {
+
+    const std::vector<long long> &column = splitColumn[index];
+    if (column.empty()) return Period(0);
+
+    long long total = IntervalKernel::sum(column.data(), column.size());
+    return Period::fromMicrosecondCount(std::llrint((double) total / (double) column.size()));
+}
+
+Period PerformanceColumn::percentile(int index, int percent) const {
+
+    std::vector<long long> column = splitColumn[index];
+    if (column.empty()) return Period(0);
+
+    // nearest rank
+    std::size_t rank = (column.size() * percent + 99) / 100;
+    std::size_t row = rank == 0 ? 0 : rank - 1;
+    std::nth_element(column.begin(), column.begin() + row, column.end());
+    return Period::fromMicrosecondCount(column[row]);
+}
+
+PerformanceColumn &PerformanceColumns::findOrAddColumn(const SplitTemplate &splitTemplate) {
+
+    auto it = columnSet.find(splitTemplate.getKey());
+    if (it == columnSet.end())
+        it = columnSet.emplace(splitTemplate.getKey(), PerformanceColumn(splitTemplate.getSize())).first;
+    return it->second;
+}
+
+void PerformanceColumns::update(const SpeedCategory &speedCategory) {
+
+    const MomentMap<SplitPerformance> &performanceMap = speedCategory.getSplitPerformanceSet();
+    const NamedMap<SplitTemplate> &templateMap = speedCategory.getSplitTemplateSet();
+    if (performanceRevision == performanceMap.getRevision() && templateRevision == templateMap.getRevision()) return;
+
+    columnSet.clear();
+    performanceMap.forEach([this](const SplitPerformance &v) {
+        findOrAddColumn(*v.getSplitTemplate()).putValue(v);
+    });
+    performanceRevision = performanceMap.getRevision();
+    templateRevision = templateMap.getRevision();
+}
+
+PerformanceColumns &PerformanceColumns::operator=(const PerformanceColumns &) {
+
+    columnSet.clear();
+    performanceRevision = 0;
+    templateRevision = 0;
+    return *this;
+}
+
+const PerformanceColumn *PerformanceColumns::getColumn(const SpeedCategory &speedCategory, const Name &templateName) {
+
+    update(speedCategory);
+    auto it = columnSet.find(templateName);
+    return it == columnSet.end() ? nullptr : &it->second;
+}
+
+void PerformanceColumns::markPut(
+        const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (performanceRevision != revisionBefore) return;
+    const SplitTemplate &splitTemplate = *value.getSplitTemplate();
+    for (auto &it: columnSet) if (it.first != splitTemplate.getKey()) it.second.delValue(value.getKey());
+
+    findOrAddColumn(splitTemplate).putValue(value);
+    performanceRevision = revisionAfter;
+}
+
+void PerformanceColumns::markDelete(
+        const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (performanceRevision != revisionBefore) return;
+    for (auto &it: columnSet) it.second.delValue(value.getKey());
+    performanceRevision = revisionAfter;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <map>
+#include <vector>
+#include "SplitMap.hpp"
+
+class SpeedCategory;
+
+class SplitTemplate;
+
+class SplitPerformance;
+
+// performances of single template stored column by column in moment order
+class PerformanceColumn {
+
+private:
+
+    // moment of each row
+    std::vector<long long> momentColumn;
+
+    // microseconds of each row for each split index
+    std::vector<std::vector<long long>> splitColumn;
+
+    // row holding moment or row it would be inserted at
+    std::size_t findRow(long long microsecondCount) const;
+
+public:
+
+    // constructor
+
+    explicit PerformanceColumn(int splitCount) : splitColumn(splitCount) {}
+
+    // getter
+
+    int getCount() const { return (int) momentColumn.size(); }
+
+    int getSplitCount() const { return (int) splitColumn.size(); }
+
+    const std::vector<long long> &getMomentColumn() const { return momentColumn; }
+
+    const std::vector<long long> &getSplitColumn(int index) const { return splitColumn[index]; }
+
+    // row operation
+
+    void putValue(const SplitPerformance &value);
+
+    bool delValue(const Moment &moment);
+
+    // column scan of split index
+
+    Period best(int index) const;
+
+    Period average(int index) const;
+
+    Period percentile(int index, int percent) const;
+};
+
+// columnar copy of performances by template name, emptied rather than copied with category
+class PerformanceColumns {
+
+private:
+
+    // column of each template with performances
+    std::map<Name, PerformanceColumn> columnSet;
+
+    // revision of performance map and of template map columns match, 0 if never built
+    std::uint64_t performanceRevision;
+    std::uint64_t templateRevision;
+
+    // column of template, created empty if missing
+    PerformanceColumn &findOrAddColumn(const SplitTemplate &splitTemplate);
+
+    // rebuild all columns when either map changed without passing through these columns
+
+    void update(const SpeedCategory &speedCategory);
+
+public:
+
+    // constructor
+
+    explicit PerformanceColumns() : performanceRevision(0), templateRevision(0) {}
+
+    PerformanceColumns(const PerformanceColumns &) : performanceRevision(0), templateRevision(0) {}
+
+    PerformanceColumns &operator=(const PerformanceColumns &);
+
+    // column of template matching current performances of category, null if template has none
+
+    const PerformanceColumn *getColumn(const SpeedCategory &speedCategory, const Name &templateName);
+
+    // mirror change of performance map from revision before to revision after, left to rebuild if already behind
+
+    void markPut(const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+
+    void markDelete(const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+};
@@ -1,3 +1,9 @@
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include "CategoryArchive.hpp"
+#include "Clock.hpp"
+#include "MappedFile.hpp"
 #include "SafeSplit.hpp"
 
 std::string SafeSplit::nextName(std::istream &stream, const std::string &message) {
@@ -25,16 +31,132 @@ int SafeSplit::nextIndex(int max, std::istream &stream, const std::string &messa
 
 Period SafeSplit::nextTime(std::istream &stream, const std::string &message) {
 
-    Assert::assertHas(stream, message + " time");
+    std::string asString = nextName(stream, message + " time");
     Period time;
-    stream >> time;
+    Assert::assertParsed(Period::parse(asString.data(), asString.size(), &time), message + " time");
     return time;
 }
 
 Moment SafeSplit::nextMoment(std::istream &stream, const std::string &message) {
 
+    return nextMoment(stream, message, Moment::fromMicrosecondCount(LLONG_MIN));
+}
+
+Moment SafeSplit::nextMoment(std::istream &stream, const std::string &message, const Moment &floor) {
+
     std::string asString = nextName(stream, message + " moment");
-    return Moment::parseWithNow(asString);
+    if (asString == Moment::nowToken) return Clock::nextKey(floor);
+    Moment moment;
+    Assert::assertParsed(Moment::parse(asString.data(), asString.size(), &moment), message + " moment");
+    return moment;
+}
+
+Date SafeSplit::nextDate(std::istream &stream, const std::string &message) {
+
+    std::string asString = nextName(stream, message + " date");
+    Date date;
+    Assert::assertParsed(Date::parse(asString.data(), asString.size(), &date), message + " date");
+    return date;
+}
+
+CalendarBucket::Unit SafeSplit::nextUnit(std::istream &stream, const std::string &message) {
+
+    std::string asString = nextName(stream, message + " unit");
+    CalendarBucket::Unit unit = CalendarBucket::day;
+    Assert::assertFound(CalendarBucket::parseUnit(asString, &unit), message + " unit");
+    return unit;
+}
+
+std::uint64_t SafeSplit::nextGeneration(std::istream &stream, const std::string &message) {
+
+    std::string asString = nextName(stream, message + " generation");
+    Assert::assertDigits(asString, message + " generation");
+    return std::stoull(asString);
+}
+
+bool SafeSplit::isBinaryFile(const std::string &fileName) {
+
+    const std::string &extension = SpeedCategory::binaryExtension;
+    return fileName.size() >= extension.size() &&
+           fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+void SafeSplit::exportCategory(const std::string &fileName, bool binary, const SpeedCategory *speedCategory) {
+
+    if (binary) {
+        std::ofstream file(fileName, std::ios::binary);
+        Assert::assertIsOpen(file.is_open(), "category");
+        BinaryWriter writer;
+        speedCategory->exportBinary(writer, true);
+        writer.writeTo(file);
+    } else {
+        std::ofstream file(fileName);
+        Assert::assertIsOpen(file.is_open(), "category");
+        TextWriter writer(&file);
+        speedCategory->exportFull(writer, true);
+    }
+}
+
+void SafeSplit::importCategory(const std::string &fileName, bool binary, SpeedCategory *speedCategory) {
+
+    if (binary) {
+        MappedFile file(fileName);
+        Assert::assertIsOpen(file.isOpen(), "category");
+
+        std::vector<NameView> nameTable;
+        BinaryReader reader(file.getBegin(), file.getEnd());
+        reader.readHeader(&nameTable);
+        SpeedCategory::importBinary(reader, speedCategory, true);
+    } else {
+        MappedFile file(fileName);
+        Assert::assertIsOpen(file.isOpen(), "category");
+        TextScanner scanner(file.getBegin(), file.getEnd());
+        SpeedCategory::importFull(scanner, speedCategory, true);
+        Assert::assertComplete(!scanner.fail(), "category file");
+    }
+}
+
+void SafeSplit::streamCategory(
+        const std::string &fileName, bool binary, SpeedCategory *speedCategory, const CategoryVisitor &visitor) {
+
+    if (binary) {
+        MappedFile file(fileName);
+        Assert::assertIsOpen(file.isOpen(), "category");
+
+        std::vector<NameView> nameTable;
+        BinaryReader reader(file.getBegin(), file.getEnd());
+        reader.readHeader(&nameTable);
+        SpeedCategory::importEachBinary(reader, speedCategory, visitor);
+    } else {
+        MappedFile file(fileName);
+        Assert::assertIsOpen(file.isOpen(), "category");
+        TextScanner scanner(file.getBegin(), file.getEnd());
+        SpeedCategory::importEach(scanner, speedCategory, visitor);
+        Assert::assertComplete(!scanner.fail(), "category file");
+    }
+}
+
+int SafeSplit::verifyCategory(const std::string &fileName) {
+
+    MappedFile file(fileName);
+    Assert::assertIsOpen(file.isOpen(), "category");
+
+    bool isArchive = file.getSize() >= (std::size_t) CategoryArchive::magicCount &&
+                     std::memcmp(file.getBegin(), CategoryArchive::magic, CategoryArchive::magicCount) == 0;
+    if (isArchive) return CategoryArchive(fileName).verify();
+
+    std::vector<NameView> nameTable;
+    BinaryReader reader(file.getBegin(), file.getEnd());
+    reader.readHeader(&nameTable);
+    if (reader.getVersion() < BinaryWriter::checksumVersion) throw std::invalid_argument("unchecksummed category file");
+
+    const std::uint32_t tagSet[] = {SpeedCategory::categoryTag, SpeedCategory::templateTag,
+                                    SpeedCategory::comparisonTag, SpeedCategory::performanceTag,
+                                    SpeedCategory::practiceTag};
+    for (std::uint32_t tag: tagSet) reader.readSection(tag);
+    Assert::assertEqual((int) reader.getRemain(), 0, "category file size");
+
+    return 1 + (int) (sizeof(tagSet) / sizeof(tagSet[0]));
 }
 
 SplitTemplate SafeSplit::newSplitTemplate(const std::string &name, int size, const SpeedCategory *speedCategory) {
@@ -105,6 +227,7 @@ const SplitComparison *SafeSplit::fillSplitComparison(
 
     Assert::assertHas(stream, splitComparison->getSplitTemplate()->getSize(), "comparison split time");
     stream >> *splitComparison;
+    Assert::assertParsed(!stream.fail(), "comparison split time");
     return splitComparison;
 }
 
@@ -134,10 +257,26 @@ const SplitPerformance *SafeSplit::getSplitPerformance(const Moment &moment, con
     return splitPerformance;
 }
 
+const SplitPerformance *SafeSplit::addSplitPerformance(
+        const SplitPerformance &splitPerformance, SpeedCategory *speedCategory) {
+
+    MomentMap<SplitPerformance> &map = speedCategory->getSplitPerformanceSet();
+    Assert::assertNonexist(splitPerformance.getKey(), map.getMap(), "performance moment");
+    std::uint64_t revision = map.getRevision();
+    const SplitPerformance *result = &map.addValue(splitPerformance);
+    speedCategory->getTemplateIndex().markPut(*result, revision, map.getRevision());
+    speedCategory->getPerformanceColumns().markPut(*result, revision, map.getRevision());
+    return result;
+}
+
 SplitPerformance SafeSplit::removeSplitPerformance(const Moment &moment, SpeedCategory *speedCategory) {
 
-    Assert::assertExist(moment, speedCategory->getSplitPerformanceSet().getMap(), "performance moment");
-    SplitPerformance splitPerformance = speedCategory->getSplitPerformanceSet().delValue(moment);
+    MomentMap<SplitPerformance> &map = speedCategory->getSplitPerformanceSet();
+    Assert::assertExist(moment, map.getMap(), "performance moment");
+    std::uint64_t revision = map.getRevision();
+    SplitPerformance splitPerformance = map.delValue(moment);
+    speedCategory->getTemplateIndex().markDelete(splitPerformance, revision, map.getRevision());
+    speedCategory->getPerformanceColumns().markDelete(splitPerformance, revision, map.getRevision());
     return splitPerformance;
 }
 
@@ -146,6 +285,7 @@ const SplitPerformance *SafeSplit::fillSplitPerformance(
 
     Assert::assertHas(stream, splitPerformance->getSplitTemplate()->getSize(), "performance split time");
     stream >> *splitPerformance;
+    Assert::assertParsed(!stream.fail(), "performance split time");
     return splitPerformance;
 }
 
@@ -160,6 +300,18 @@ const SplitPerformance *SafeSplit::copySplitPerformance(
     return splitPerformanceDestination;
 }
 
+const SplitPerformance *SafeSplit::touchSplitPerformance(
+        const SplitPerformance *splitPerformance, SpeedCategory *speedCategory) {
+
+    MomentMap<SplitPerformance> &map = speedCategory->getSplitPerformanceSet();
+    Assert::assertExist(splitPerformance->getKey(), map.getMap(), "performance moment");
+    std::uint64_t revision = map.getRevision();
+    map.touch();
+    speedCategory->getTemplateIndex().markPut(*splitPerformance, revision, map.getRevision());
+    speedCategory->getPerformanceColumns().markPut(*splitPerformance, revision, map.getRevision());
+    return splitPerformance;
+}
+
 SplitPractice SafeSplit::newSplitPractice(int splitIndex, const Moment &moment, const SplitTemplate *splitTemplate) {
 
     Assert::assertNonexist(
@@ -175,9 +327,22 @@ const SplitPractice *SafeSplit::getSplitPractice(const Moment &moment, const Spe
     return splitPractice;
 }
 
+const SplitPractice *SafeSplit::addSplitPractice(const SplitPractice &splitPractice, SpeedCategory *speedCategory) {
+
+    MomentMap<SplitPractice> &map = speedCategory->getSplitPracticeSet();
+    Assert::assertNonexist(splitPractice.getKey(), map.getMap(), "practice moment");
+    std::uint64_t revision = map.getRevision();
+    const SplitPractice *result = &map.addValue(splitPractice);
+    speedCategory->getTemplateIndex().markPut(*result, revision, map.getRevision());
+    return result;
+}
+
 SplitPractice SafeSplit::removeSplitPractice(const Moment &moment, SpeedCategory *speedCategory) {
 
-    Assert::assertExist(moment, speedCategory->getSplitPracticeSet().getMap(), "practice moment");
-    SplitPractice splitPractice = speedCategory->getSplitPracticeSet().delValue(moment);
+    MomentMap<SplitPractice> &map = speedCategory->getSplitPracticeSet();
+    Assert::assertExist(moment, map.getMap(), "practice moment");
+    std::uint64_t revision = map.getRevision();
+    SplitPractice splitPractice = map.delValue(moment);
+    speedCategory->getTemplateIndex().markDelete(splitPractice, revision, map.getRevision());
     return splitPractice;
 }
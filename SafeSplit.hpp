@@ -1,6 +1,7 @@
 #pragma once
 #include "Split.hpp"
 #include "Assertion.hpp"
+#include "CalendarBucket.hpp"
 
 // safe operations on splits with assertions on user input
 namespace SafeSplit {
@@ -20,6 +21,34 @@ namespace SafeSplit {
     // retrieve parsed moment from stream
     Moment nextMoment(std::istream &stream, const std::string &message);
 
+    // retrieve parsed moment for new entry, now token taking key after floor so it misses entries up to floor
+    Moment nextMoment(std::istream &stream, const std::string &message, const Moment &floor);
+
+    // retrieve parsed date from stream
+    Date nextDate(std::istream &stream, const std::string &message);
+
+    // retrieve calendar bucket unit from stream
+    CalendarBucket::Unit nextUnit(std::istream &stream, const std::string &message);
+
+    // retrieve valid generation counter from stream
+    std::uint64_t nextGeneration(std::istream &stream, const std::string &message);
+
+    // check whether file name selects binary category format
+    bool isBinaryFile(const std::string &fileName);
+
+    // export category to text or binary file
+    void exportCategory(const std::string &fileName, bool binary, const SpeedCategory *speedCategory);
+
+    // import category from text or binary file
+    void importCategory(const std::string &fileName, bool binary, SpeedCategory *speedCategory);
+
+    // stream category from text or binary file to visitor, keeping only name and templates
+    void streamCategory(
+            const std::string &fileName, bool binary, SpeedCategory *speedCategory, const CategoryVisitor &visitor);
+
+    // check checksums of binary category file or archive without building category and return checked count
+    int verifyCategory(const std::string &fileName);
+
     // create new split template and add to category
     SplitTemplate newSplitTemplate(const std::string &name, int size, const SpeedCategory *speedCategory);
 
@@ -58,6 +87,9 @@ namespace SafeSplit {
     // get split performance from category
     const SplitPerformance *getSplitPerformance(const Moment &moment, const SpeedCategory *speedCategory);
 
+    // add split performance to category and its indexes
+    const SplitPerformance *addSplitPerformance(const SplitPerformance &splitPerformance, SpeedCategory *speedCategory);
+
     // remove split performance from category
     SplitPerformance removeSplitPerformance(const Moment &moment, SpeedCategory *speedCategory);
 
@@ -68,12 +100,19 @@ namespace SafeSplit {
     const SplitPerformance *copySplitPerformance(
             const SplitPerformance *splitPerformanceSource, const SplitPerformance *splitPerformanceDestination);
 
+    // mark split performance of category retimed in place, advancing performance map and its indexes
+    const SplitPerformance *touchSplitPerformance(
+            const SplitPerformance *splitPerformance, SpeedCategory *speedCategory);
+
     // create new split practice and add to template
     SplitPractice newSplitPractice(int splitIndex, const Moment &moment, const SplitTemplate *splitTemplate);
 
     // get split practice from category
     const SplitPractice *getSplitPractice(const Moment &moment, const SpeedCategory *speedCategory);
 
+    // add split practice to category and template index
+    const SplitPractice *addSplitPractice(const SplitPractice &splitPractice, SpeedCategory *speedCategory);
+
     // remove split practice from category
     SplitPractice removeSplitPractice(const Moment &moment, SpeedCategory *speedCategory);
 }
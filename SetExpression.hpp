@@ -0,0 +1,190 @@
+#pragma once
+#include <string>
+#include "IntervalKernel.hpp"
+
+// lazy arithmetic over interval sets and name sets, evaluated in one pass into destination
+
+// how operand is held by enclosing expression, sets by reference and expressions by value
+template<class E>
+struct ExpressionOperand {
+
+    typedef const E type;
+};
+
+// interval expression
+
+// microsecond counts evaluated per block, sized to stay in cache
+static const int intervalBlockSize = 256;
+
+// interval expression of derived type D, which provides getSize and
+// evaluate(start, size, buffer) returning counts of block [start, start + size),
+// written to buffer unless already stored
+template<class D>
+class IntervalExpression {
+
+public:
+
+    const D &self() const { return static_cast<const D &>(*this); }
+};
+
+// elementwise sum or difference of two interval expressions
+template<class L, class R, bool subtract>
+class IntervalJoin : public IntervalExpression<IntervalJoin<L, R, subtract>> {
+
+private:
+
+    typename ExpressionOperand<L>::type left;
+    typename ExpressionOperand<R>::type right;
+
+public:
+
+    // constructor
+
+    explicit IntervalJoin(const L &left, const R &right) : left(left), right(right) {}
+
+    // getter
+
+    int getSize() const { return left.getSize(); }
+
+    // evaluation
+
+    const long long *evaluate(int start, int size, long long *buffer) const {
+
+        long long other[intervalBlockSize];
+        const long long *x = left.evaluate(start, size, buffer);
+        const long long *y = right.evaluate(start, size, other);
+        if (subtract) IntervalKernel::subtract(x, y, buffer, size);
+        else IntervalKernel::add(x, y, buffer, size);
+        return buffer;
+    }
+};
+
+// interval expression multiplied or divided by number, rounded to nearest
+template<class E, bool divide>
+class IntervalScale : public IntervalExpression<IntervalScale<E, divide>> {
+
+private:
+
+    typename ExpressionOperand<E>::type operand;
+    double factor;
+
+public:
+
+    // constructor
+
+    explicit IntervalScale(const E &operand, double factor) : operand(operand), factor(factor) {}
+
+    // getter
+
+    int getSize() const { return operand.getSize(); }
+
+    // evaluation
+
+    const long long *evaluate(int start, int size, long long *buffer) const {
+
+        const long long *x = operand.evaluate(start, size, buffer);
+        if (divide) IntervalKernel::divide(x, factor, buffer, size);
+        else IntervalKernel::multiply(x, factor, buffer, size);
+        return buffer;
+    }
+};
+
+// interval operator
+
+template<class L, class R>
+IntervalJoin<L, R, false> operator+(const IntervalExpression<L> &a, const IntervalExpression<R> &b) {
+
+    return IntervalJoin<L, R, false>(a.self(), b.self());
+}
+
+template<class L, class R>
+IntervalJoin<L, R, true> operator-(const IntervalExpression<L> &a, const IntervalExpression<R> &b) {
+
+    return IntervalJoin<L, R, true>(a.self(), b.self());
+}
+
+template<class E>
+IntervalScale<E, false> operator*(const IntervalExpression<E> &a, double b) {
+
+    return IntervalScale<E, false>(a.self(), b);
+}
+
+template<class E>
+IntervalScale<E, true> operator/(const IntervalExpression<E> &a, double b) {
+
+    return IntervalScale<E, true>(a.self(), b);
+}
+
+// name expression
+
+// name expression of derived type D, which provides getSize and
+// appendName(index, result) appending name of element at index
+template<class D>
+class NameExpression {
+
+public:
+
+    const D &self() const { return static_cast<const D &>(*this); }
+};
+
+// names of two name expressions joined by operator
+template<class L, class R>
+class NameJoin : public NameExpression<NameJoin<L, R>> {
+
+private:
+
+    typename ExpressionOperand<L>::type left;
+    typename ExpressionOperand<R>::type right;
+    char joinOperator;
+
+public:
+
+    // constructor
+
+    explicit NameJoin(const L &left, const R &right, char joinOperator) :
+            left(left), right(right), joinOperator(joinOperator) {}
+
+    // getter
+
+    int getSize() const { return left.getSize(); }
+
+    // evaluation
+
+    void appendName(int index, std::string *result) const {
+
+        left.appendName(index, result);
+        result->push_back(joinOperator);
+        right.appendName(index, result);
+    }
+};
+
+// names of name expression followed by operator and number
+template<class E>
+class NameScale : public NameExpression<NameScale<E>> {
+
+private:
+
+    typename ExpressionOperand<E>::type operand;
+
+    // operator and number, formatted once for all elements
+    std::string suffix;
+
+public:
+
+    // constructor
+
+    explicit NameScale(const E &operand, char scaleOperator, double factor) :
+            operand(operand), suffix(scaleOperator + std::to_string(factor)) {}
+
+    // getter
+
+    int getSize() const { return operand.getSize(); }
+
+    // evaluation
+
+    void appendName(int index, std::string *result) const {
+
+        operand.appendName(index, result);
+        result->append(suffix);
+    }
+};
@@ -1,3 +1,90 @@
+#include <exception>
+#include <system_error>
+#include <thread>
 #include "Split.hpp"
+#include "Assertion.hpp"
 
 const SpeedCategory *SpeedCategory::activeImport = nullptr;
+
+const std::string SpeedCategory::binaryExtension = ".splits";
+
+const std::uint32_t SpeedCategory::categoryTag = 0x47544143;
+const std::uint32_t SpeedCategory::templateTag = 0x4c504d54;
+const std::uint32_t SpeedCategory::comparisonTag = 0x504d4f43;
+const std::uint32_t SpeedCategory::performanceTag = 0x46524550;
+const std::uint32_t SpeedCategory::practiceTag = 0x43415250;
+
+const SplitTemplate *SpeedCategory::resolveTemplate(const NameView &name) const {
+
+    int id = splitTemplateSet.findId(name.getData(), name.getSize());
+    Assert::assertFound(id >= 0, "category file template");
+    return &splitTemplateSet.getValueById(id);
+}
+
+const SplitTemplate *SpeedCategory::resolveTemplate(const Name &name) const {
+
+    return resolveTemplate(NameView(name.data(), (std::uint32_t) name.size()));
+}
+
+void SpeedCategory::adopt(SpeedCategory &staged) {
+
+    // map nodes and vector storage move with their containers, so values keep their addresses
+    *this = std::move(staged);
+    for (auto &it: splitTemplateSet.map) it.second.speedCategory = this;
+}
+
+void SpeedCategory::copyInto(SpeedCategory *staged) const {
+
+    staged->HasName::operator=(*this);
+    splitTemplateSet.forEach([staged](const SplitTemplate &v) {
+        SplitTemplate splitTemplate(v.getKey(), v.getSize(), staged);
+        splitTemplate.copy(v);
+        staged->splitTemplateSet.addValue(std::move(splitTemplate));
+    });
+    splitComparisonSet.forEach([staged](const SplitComparison &v) {
+        SplitComparison splitComparison(v.getKey(), staged->resolveTemplate(v.getSplitTemplate()->getKey()));
+        splitComparison.copy(v);
+        staged->splitComparisonSet.addValue(std::move(splitComparison));
+    });
+    splitPerformanceSet.forEach([staged](const SplitPerformance &v) {
+        SplitPerformance splitPerformance(v.getKey(), staged->resolveTemplate(v.getSplitTemplate()->getKey()));
+        splitPerformance.copy(v);
+        staged->splitPerformanceSet.addValue(std::move(splitPerformance));
+    });
+    splitPracticeSet.forEach([staged](const SplitPractice &v) {
+        SplitPractice splitPractice(
+                v.getSplitIndex(), v.getKey(), staged->resolveTemplate(v.getSplitTemplate()->getKey()));
+        splitPractice.getTime() = v.getTime();
+        staged->splitPracticeSet.addValue(std::move(splitPractice));
+    });
+}
+
+void SpeedCategory::runConcurrently(const std::vector<std::function<void()>> &taskSet) {
+
+    std::vector<std::exception_ptr> errorSet(taskSet.size());
+    auto runTask = [&taskSet, &errorSet](std::size_t i) {
+        try {
+            taskSet[i]();
+        } catch (...) {
+            errorSet[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threadSet;
+    bool isParallel = std::thread::hardware_concurrency() > 1;
+    for (std::size_t i = 1; i < taskSet.size(); i++) {
+        if (!isParallel) {
+            runTask(i);
+            continue;
+        }
+        try {
+            threadSet.emplace_back(runTask, i);
+        } catch (const std::system_error &) {
+            runTask(i);
+        }
+    }
+
+    if (!taskSet.empty()) runTask(0);
+    for (std::thread &thread: threadSet) thread.join();
+    for (const std::exception_ptr &error: errorSet) if (error) std::rethrow_exception(error);
+}
@@ -1,6 +1,10 @@
 #pragma once
+#include <functional>
 #include "SplitSet.hpp"
 #include "SplitMap.hpp"
+#include "TemplateIndex.hpp"
+#include "PerformanceColumns.hpp"
+#include "Assertion.hpp"
 
 class SpeedCategory;
 
@@ -14,6 +18,18 @@ class SplitPerformance;
 
 class SplitPractice;
 
+// callbacks for streaming category import
+class CategoryVisitor {
+
+public:
+
+    // called once per value in file order, if set
+    std::function<void(const SplitTemplate &)> visitTemplate;
+    std::function<void(const SplitComparison &)> visitComparison;
+    std::function<void(const SplitPerformance &)> visitPerformance;
+    std::function<void(const SplitPractice &)> visitPractice;
+};
+
 // speedrunning category
 class SpeedCategory : public HasName {
 
@@ -25,11 +41,30 @@ private:
     MomentMap<SplitPerformance> splitPerformanceSet;
     MomentMap<SplitPractice> splitPracticeSet;
 
+    // moments of split instances by template, kept in step with maps by safe add and remove
+    mutable TemplateIndex templateIndex;
+
+    // columnar copy of performances by template, rebuilt when performance or template map changed elsewhere
+    mutable PerformanceColumns performanceColumns;
+
     // pointer to active speed category when importing from file io
     static const SpeedCategory *activeImport;
 
+    // run tasks on worker threads and rethrow first failure after all finish
+    static void runConcurrently(const std::vector<std::function<void()>> &taskSet);
+
 public:
 
+    // file extension selecting binary file io
+    static const std::string binaryExtension;
+
+    // binary file section tag
+    static const std::uint32_t categoryTag;
+    static const std::uint32_t templateTag;
+    static const std::uint32_t comparisonTag;
+    static const std::uint32_t performanceTag;
+    static const std::uint32_t practiceTag;
+
     // constructor
 
     explicit SpeedCategory() : HasName("") {}
@@ -50,15 +85,32 @@ public:
 
     const NamedMap<SplitTemplate> &getSplitTemplateSet() const { return splitTemplateSet; }
 
+    // split template named in file by interned id, asserting that file defined it
+
+    const SplitTemplate *resolveTemplate(const NameView &name) const;
+
+    const SplitTemplate *resolveTemplate(const Name &name) const;
+
     const NamedMap<SplitComparison> &getSplitComparisonSet() const { return splitComparisonSet; }
 
     const MomentMap<SplitPerformance> &getSplitPerformanceSet() const { return splitPerformanceSet; }
 
     const MomentMap<SplitPractice> &getSplitPracticeSet() const { return splitPracticeSet; }
 
+    TemplateIndex &getTemplateIndex() const { return templateIndex; }
+
+    PerformanceColumns &getPerformanceColumns() const { return performanceColumns; }
+
+    // take maps of fully imported category, pointing its templates at this category
+    void adopt(SpeedCategory &staged);
+
+    // fill empty staged category with copy of this category, its instances pointing at its own templates
+    void copyInto(SpeedCategory *staged) const;
+
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         HasName::exportFull(stream, newObject);
         splitTemplateSet.exportFull(stream, true);
@@ -68,24 +120,149 @@ public:
         return stream;
     }
 
-    static SpeedCategory *importFull(std::istream &stream, SpeedCategory *result, bool newObject) {
+    template<class In>
+    static SpeedCategory *importFull(In &stream, SpeedCategory *result, bool newObject) {
+
+        // import into staged category so failed read leaves result as it was
+        SpeedCategory staged(result->getKey());
+        activeImport = &staged;
+        HasName::importFull(stream, &staged, newObject);
+
+        NamedMap<SplitTemplate>::importFull(stream, &staged.splitTemplateSet, true);
+        NamedMap<SplitComparison>::importFull(stream, &staged.splitComparisonSet, true);
+        MomentMap<SplitPerformance>::importFull(stream, &staged.splitPerformanceSet, true);
+        MomentMap<SplitPractice>::importFull(stream, &staged.splitPracticeSet, true);
+
+        activeImport = nullptr;
+        if (stream) result->adopt(staged);
+        return result;
+    }
+
+    // stream category to visitor keeping only name and templates
+
+    template<class In>
+    static SpeedCategory *importEach(In &stream, SpeedCategory *result, const CategoryVisitor &visitor) {
 
         activeImport = result;
-        HasName::importFull(stream, result, newObject);
+        HasName::importFull(stream, result, true);
 
         NamedMap<SplitTemplate>::importFull(stream, &result->splitTemplateSet, true);
-        NamedMap<SplitComparison>::importFull(stream, &result->splitComparisonSet, true);
-        MomentMap<SplitPerformance>::importFull(stream, &result->splitPerformanceSet, true);
-        MomentMap<SplitPractice>::importFull(stream, &result->splitPracticeSet, true);
+        result->splitTemplateSet.forEach([&visitor](const SplitTemplate &v) {
+            if (visitor.visitTemplate) visitor.visitTemplate(v);
+        });
+
+        NamedMap<SplitComparison>::importEach(stream, [&visitor](const SplitComparison &v) {
+            if (visitor.visitComparison) visitor.visitComparison(v);
+        });
+        MomentMap<SplitPerformance>::importEach(stream, [&visitor](const SplitPerformance &v) {
+            if (visitor.visitPerformance) visitor.visitPerformance(v);
+        });
+        MomentMap<SplitPractice>::importEach(stream, [&visitor](const SplitPractice &v) {
+            if (visitor.visitPractice) visitor.visitPractice(v);
+        });
 
         activeImport = nullptr;
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        writer.beginSection(categoryTag);
+        HasName::exportBinary(writer, newObject);
+        writer.endSection();
+
+        writer.beginSection(templateTag);
+        splitTemplateSet.exportBinary(writer, true);
+        writer.endSection();
+
+        writer.beginSection(comparisonTag);
+        splitComparisonSet.exportBinary(writer, true);
+        writer.endSection();
+
+        writer.beginSection(performanceTag);
+        splitPerformanceSet.exportBinary(writer, true);
+        writer.endSection();
+
+        writer.beginSection(practiceTag);
+        splitPracticeSet.exportBinary(writer, true);
+        writer.endSection();
+
+        return writer;
+    }
+
+    static SpeedCategory *importBinary(BinaryReader &reader, SpeedCategory *result, bool newObject) {
+
+        // frame and check every section, then decode into staged category so failure leaves result as it was
+        SpeedCategory staged(result->getKey());
+        reader.setSpeedCategory(&staged);
+
+        BinaryReader categorySection = reader.readSection(categoryTag);
+        BinaryReader templateSection = reader.readSection(templateTag);
+        BinaryReader comparisonSection = reader.readSection(comparisonTag);
+        BinaryReader performanceSection = reader.readSection(performanceTag);
+        BinaryReader practiceSection = reader.readSection(practiceTag);
+
+        HasName::importBinary(categorySection, &staged, newObject);
+        NamedMap<SplitTemplate>::importBinary(templateSection, &staged.splitTemplateSet, true);
+
+        // templates are complete so remaining sections only read them and their index while filling their own map
+        staged.splitTemplateSet.updateIndex();
+        SpeedCategory *target = &staged;
+        runConcurrently({
+                [&comparisonSection, target]() {
+                    NamedMap<SplitComparison>::importBinary(comparisonSection, &target->splitComparisonSet, true);
+                },
+                [&performanceSection, target]() {
+                    MomentMap<SplitPerformance>::importBinary(performanceSection, &target->splitPerformanceSet, true);
+                },
+                [&practiceSection, target]() {
+                    MomentMap<SplitPractice>::importBinary(practiceSection, &target->splitPracticeSet, true);
+                }});
+
+        reader.setSpeedCategory(result);
+        result->adopt(staged);
+        return result;
+    }
+
+    static SpeedCategory *importEachBinary(BinaryReader &reader, SpeedCategory *result, const CategoryVisitor &visitor) {
+
+        reader.setSpeedCategory(result);
+
+        BinaryReader categorySection = reader.readSection(categoryTag);
+        HasName::importBinary(categorySection, result, true);
+
+        BinaryReader templateSection = reader.readSection(templateTag);
+        NamedMap<SplitTemplate>::importBinary(templateSection, &result->splitTemplateSet, true);
+        result->splitTemplateSet.forEach([&visitor](const SplitTemplate &v) {
+            if (visitor.visitTemplate) visitor.visitTemplate(v);
+        });
+
+        BinaryReader comparisonSection = reader.readSection(comparisonTag);
+        NamedMap<SplitComparison>::importEachBinary(comparisonSection, [&visitor](const SplitComparison &v) {
+            if (visitor.visitComparison) visitor.visitComparison(v);
+        });
+
+        BinaryReader performanceSection = reader.readSection(performanceTag);
+        MomentMap<SplitPerformance>::importEachBinary(performanceSection, [&visitor](const SplitPerformance &v) {
+            if (visitor.visitPerformance) visitor.visitPerformance(v);
+        });
+
+        BinaryReader practiceSection = reader.readSection(practiceTag);
+        MomentMap<SplitPractice>::importEachBinary(practiceSection, [&visitor](const SplitPractice &v) {
+            if (visitor.visitPractice) visitor.visitPractice(v);
+        });
+
+        return result;
+    }
 };
 
 // split template containing split names for route
 class SplitTemplate : public HasName, public NameSet {
 
+    friend class SpeedCategory;
+
 private:
 
     // pointer to relevant category
@@ -106,21 +283,25 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const SplitTemplate &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const SplitTemplate &a) {
 
-        return stream << static_cast<HasName>(a) << " " << static_cast<NameSet>(a);
+        stream << static_cast<const HasName &>(a) << " " << static_cast<const NameSet &>(a);
+        return stream;
     }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         HasName::exportFull(stream, newObject);
         NameSet::exportFull(stream, newObject);
         return stream;
     }
 
-    static SplitTemplate *importFull(std::istream &stream, SplitTemplate *result, bool newObject) {
+    template<class In>
+    static SplitTemplate *importFull(In &stream, SplitTemplate *result, bool newObject) {
 
         if (newObject) {
             Name name;
@@ -135,6 +316,30 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        HasName::exportBinary(writer, newObject);
+        NameSet::exportBinary(writer, newObject);
+        return writer;
+    }
+
+    static SplitTemplate *importBinary(BinaryReader &reader, SplitTemplate *result, bool newObject) {
+
+        if (newObject) {
+            Name name;
+            Name::importBinary(reader, &name, true);
+            int size = (int) reader.readCount();
+            *result = SplitTemplate(name, size, reader.getSpeedCategory());
+        }
+
+        HasName::importBinary(reader, result, false);
+        NameSet::importBinary(reader, result, false);
+
+        return result;
+    }
 };
 
 // instance of timed split for route
@@ -159,30 +364,48 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const SplitInstance &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const SplitInstance &a) {
 
-        return stream << a.splitTemplate->getKey();
+        stream << a.splitTemplate->getKey();
+        return stream;
     }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         splitTemplate->HasName::exportFull(stream, newObject);
         return stream;
     }
 
-    static SplitInstance *importFull(std::istream &stream, SplitInstance *result, bool newObject) {
+    template<class In>
+    static SplitInstance *importFull(In &stream, SplitInstance *result, bool newObject) {
 
         if (newObject) {
             Name templateName;
             Name::importFull(stream, &templateName, true);
             *result = SplitInstance(
-                    &SpeedCategory::getActiveImport()->getSplitTemplateSet().getValue(Name(templateName)));
+                    SpeedCategory::getActiveImport()->resolveTemplate(templateName));
         }
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        splitTemplate->HasName::exportBinary(writer, newObject);
+        return writer;
+    }
+
+    // template is resolved by derived instance when it constructs result, nothing further to read
+    static SplitInstance *importBinary(BinaryReader &, SplitInstance *result, bool) {
+
+        return result;
+    }
 };
 
 // timed comparison for route
@@ -199,14 +422,17 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const SplitComparison &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const SplitComparison &a) {
 
-        return stream << static_cast<HasName>(a) << " " << static_cast<IntervalSet>(a);
+        stream << static_cast<const HasName &>(a) << " " << static_cast<const IntervalSet &>(a);
+        return stream;
     }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         HasName::exportFull(stream, newObject);
         SplitInstance::exportFull(stream, newObject);
@@ -214,7 +440,8 @@ public:
         return stream;
     }
 
-    static SplitComparison *importFull(std::istream &stream, SplitComparison *result, bool newObject) {
+    template<class In>
+    static SplitComparison *importFull(In &stream, SplitComparison *result, bool newObject) {
 
         if (newObject) {
             Name name;
@@ -222,7 +449,7 @@ public:
             Name templateName;
             Name::importFull(stream, &templateName, true);
             *result = SplitComparison(
-                    name, &SpeedCategory::getActiveImport()->getSplitTemplateSet().getValue(Name(templateName)));
+                    name, SpeedCategory::getActiveImport()->resolveTemplate(templateName));
         }
 
         HasName::importFull(stream, result, false);
@@ -231,6 +458,31 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        HasName::exportBinary(writer, newObject);
+        SplitInstance::exportBinary(writer, newObject);
+        IntervalSet::exportBinary(writer, false);
+        return writer;
+    }
+
+    static SplitComparison *importBinary(BinaryReader &reader, SplitComparison *result, bool newObject) {
+
+        if (newObject) {
+            Name name;
+            Name::importBinary(reader, &name, true);
+            *result = SplitComparison(name, reader.getSpeedCategory()->resolveTemplate(reader.readName()));
+        }
+
+        HasName::importBinary(reader, result, false);
+        SplitInstance::importBinary(reader, result, false);
+        IntervalSet::importBinary(reader, result, false);
+
+        return result;
+    }
 };
 
 
@@ -248,14 +500,17 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const SplitPerformance &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const SplitPerformance &a) {
 
-        return stream << static_cast<HasMoment>(a) << " " << static_cast<IntervalSet>(a);
+        stream << static_cast<const HasMoment &>(a) << " " << static_cast<const IntervalSet &>(a);
+        return stream;
     }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         HasMoment::exportFull(stream, newObject);
         SplitInstance::exportFull(stream, newObject);
@@ -263,7 +518,8 @@ public:
         return stream;
     }
 
-    static SplitPerformance *importFull(std::istream &stream, SplitPerformance *result, bool newObject) {
+    template<class In>
+    static SplitPerformance *importFull(In &stream, SplitPerformance *result, bool newObject) {
 
         if (newObject) {
             Moment moment;
@@ -271,7 +527,7 @@ public:
             Name templateName;
             Name::importFull(stream, &templateName, true);
             *result = SplitPerformance(
-                    moment, &SpeedCategory::getActiveImport()->getSplitTemplateSet().getValue(Name(templateName)));
+                    moment, SpeedCategory::getActiveImport()->resolveTemplate(templateName));
         }
 
         HasMoment::importFull(stream, result, false);
@@ -280,6 +536,31 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        HasMoment::exportBinary(writer, newObject);
+        SplitInstance::exportBinary(writer, newObject);
+        IntervalSet::exportBinary(writer, false);
+        return writer;
+    }
+
+    static SplitPerformance *importBinary(BinaryReader &reader, SplitPerformance *result, bool newObject) {
+
+        if (newObject) {
+            Moment moment;
+            Moment::importBinary(reader, &moment, true);
+            *result = SplitPerformance(moment, reader.getSpeedCategory()->resolveTemplate(reader.readName()));
+        }
+
+        HasMoment::importBinary(reader, result, false);
+        SplitInstance::importBinary(reader, result, false);
+        IntervalSet::importBinary(reader, result, false);
+
+        return result;
+    }
 };
 
 // time practice of split in route
@@ -304,18 +585,23 @@ public:
 
     // getter
 
+    int getSplitIndex() const { return splitIndex; }
+
     Period &getTime() const { return time; }
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const SplitPractice &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const SplitPractice &a) {
 
-        return stream << static_cast<HasMoment>(a) << " " << a.splitIndex << " " << a.time;
+        stream << static_cast<const HasMoment &>(a) << " " << a.splitIndex << " " << a.time;
+        return stream;
     }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         HasMoment::exportFull(stream, newObject);
         SplitInstance::exportFull(stream, newObject);
@@ -324,18 +610,19 @@ public:
         return stream;
     }
 
-    static SplitPractice *importFull(std::istream &stream, SplitPractice *result, bool newObject) {
+    template<class In>
+    static SplitPractice *importFull(In &stream, SplitPractice *result, bool newObject) {
 
         if (newObject) {
             Moment moment;
             Moment::importFull(stream, &moment, true);
             Name templateName;
             Name::importFull(stream, &templateName, true);
-            int splitIndex;
+            const SplitTemplate *splitTemplate = SpeedCategory::getActiveImport()->resolveTemplate(templateName);
+            int splitIndex = 0;
             stream >> splitIndex;
-            *result = SplitPractice(
-                    splitIndex, moment,
-                    &SpeedCategory::getActiveImport()->getSplitTemplateSet().getValue(Name(templateName)));
+            Assert::assertRange(splitIndex, splitTemplate->getSize(), "split index");
+            *result = SplitPractice(splitIndex, moment, splitTemplate);
         }
 
         HasMoment::importFull(stream, result, false);
@@ -344,4 +631,33 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        HasMoment::exportBinary(writer, newObject);
+        SplitInstance::exportBinary(writer, newObject);
+        writer.writeI32(splitIndex);
+        time.exportBinary(writer, false);
+        return writer;
+    }
+
+    static SplitPractice *importBinary(BinaryReader &reader, SplitPractice *result, bool newObject) {
+
+        if (newObject) {
+            Moment moment;
+            Moment::importBinary(reader, &moment, true);
+            const SplitTemplate *splitTemplate = reader.getSpeedCategory()->resolveTemplate(reader.readName());
+            int splitIndex = reader.readI32();
+            Assert::assertRange(splitIndex, splitTemplate->getSize(), "split index");
+            *result = SplitPractice(splitIndex, moment, splitTemplate);
+        }
+
+        HasMoment::importBinary(reader, result, false);
+        SplitInstance::importBinary(reader, result, false);
+        Period::importBinary(reader, &result->time, false);
+
+        return result;
+    }
 };
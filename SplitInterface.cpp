@@ -7,6 +7,19 @@ SplitInterface::SplitInterface(std::istream *inputStream, std::ostream *outputSt
     addCommand("OutputCategory", outputCategory);
     addCommand("ExportCategory", exportCategory);
     addCommand("ImportCategory", importCategory);
+    addCommand("ExportCategoryBinary", exportCategoryBinary);
+    addCommand("ImportCategoryBinary", importCategoryBinary);
+    addCommand("ViewCategory", viewCategory);
+    addCommand("StreamCategory", streamCategory);
+    addCommand("VerifyCategory", verifyCategory);
+    addCommand("OpenJournal", openJournal);
+    addCommand("CompactJournal", compactJournal);
+    addCommand("CloseJournal", closeJournal);
+    addCommand("ExportArchive", exportArchive);
+    addCommand("ImportArchive", importArchive);
+    addCommand("ExportDelta", exportDelta);
+    addCommand("ImportDelta", importDelta);
+    addCommand("OutputGeneration", outputGeneration);
 
     addCommand("NewTemplate", newTemplate);
     addCommand("NewTemplateWithSplits", newTemplateWithSplits);
@@ -19,6 +32,7 @@ SplitInterface::SplitInterface(std::istream *inputStream, std::ostream *outputSt
 
     addCommand("NewComparison", newComparison);
     addCommand("NewComparisonWithSplits", newComparisonWithSplits);
+    addCommand("NewComparisonFromAverage", newComparisonFromAverage);
     addCommand("RetimeComparisonAllSplits", retimeComparisonAllSplits);
     addCommand("RetimeComparisonAtSplit", retimeComparisonAtSplit);
     addCommand("CopyComparisonSplits", copyComparisonSplits);
@@ -32,16 +46,36 @@ SplitInterface::SplitInterface(std::istream *inputStream, std::ostream *outputSt
     addCommand("RetimePerformanceAtSplit", retimePerformanceAtSplit);
     addCommand("CopyPerformanceSplits", copyPerformanceSplits);
     addCommand("OutputAllPerformances", outputAllPerformances);
+    addCommand("OutputPerformancesBetween", outputPerformancesBetween);
+    addCommand("OutputPerformancesOnDays", outputPerformancesOnDays);
+    addCommand("OutputPerformancesOfTemplate", outputPerformancesOfTemplate);
+    addCommand("OutputPerformanceBuckets", outputPerformanceBuckets);
     addCommand("OutputAtPerformance", outputAtPerformance);
     addCommand("DeletePerformance", deletePerformance);
+    addCommand("OutputAtArchivedPerformance", outputAtArchivedPerformance);
+    addCommand("OutputSplitStatistics", outputSplitStatistics);
 
     addCommand("NewPractice", newPractice);
     addCommand("NewPracticeWithTime", newPracticeWithTime);
     addCommand("RetimePractice", retimePractice);
     addCommand("CopyPracticeTime", copyPracticeTime);
     addCommand("OutputAllPractices", outputAllPractices);
+    addCommand("OutputPracticesBetween", outputPracticesBetween);
+    addCommand("OutputPracticesOnDays", outputPracticesOnDays);
+    addCommand("OutputPracticesOfTemplate", outputPracticesOfTemplate);
+    addCommand("OutputPracticeBuckets", outputPracticeBuckets);
     addCommand("OutputAtPractice", outputAtPractice);
     addCommand("DeletePractice", deletePractice);
+    addCommand("OutputAtArchivedPractice", outputAtArchivedPractice);
+
+    addCommand("BenchmarkTextImport", benchmarkTextImport);
+    addCommand("BenchmarkTextExport", benchmarkTextExport);
+    addCommand("BenchmarkMemoryCycle", benchmarkMemoryCycle);
+    addCommand("BenchmarkCategoryArena", benchmarkCategoryArena);
+    addCommand("BenchmarkSplitScan", benchmarkSplitScan);
+    addCommand("BenchmarkIntervalKernel", benchmarkIntervalKernel);
+    addCommand("BenchmarkTimeFormat", benchmarkTimeFormat);
+    addCommand("BenchmarkClock", benchmarkClock);
 }
 
 SpeedCategory *SplitInterface::getSpeedCategory() {
@@ -54,13 +88,54 @@ SpeedCategory *SplitInterface::extractSpeedCategory(Interface *interface) {
     return dynamic_cast<SplitInterface *>(interface)->getSpeedCategory();
 }
 
+CategoryJournal *SplitInterface::getCategoryJournal() {
+
+    return &categoryJournal;
+}
+
+CategoryJournal *SplitInterface::extractCategoryJournal(Interface *interface) {
+
+    return dynamic_cast<SplitInterface *>(interface)->getCategoryJournal();
+}
+
+CategoryDelta *SplitInterface::getCategoryDelta() {
+
+    return &categoryDelta;
+}
+
+CategoryDelta *SplitInterface::extractCategoryDelta(Interface *interface) {
+
+    return dynamic_cast<SplitInterface *>(interface)->getCategoryDelta();
+}
+
+void SplitInterface::detachJournal(Interface *interface, std::ostream &out) {
+
+    CategoryJournal &journal = *extractCategoryJournal(interface);
+    if (!journal.isOpen()) return;
+    out << "CLOSE JOURNAL:" << std::endl << journal.getSnapshotName() << std::endl;
+    journal.close();
+}
+
+void SplitInterface::recordReplace(Interface *interface) {
+
+    extractCategoryDelta(interface)->markNew();
+}
+
+void SplitInterface::recordImport(Interface *interface) {
+
+    extractCategoryJournal(interface)->compact();
+    extractCategoryDelta(interface)->markNew();
+}
+
 // creates new category [CATEGORY_NAME]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::newCategory =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
             std::string name = SafeSplit::nextName(arg, "category");
+            detachJournal(interface, out);
             category = SpeedCategory(name);
+            recordReplace(interface);
             out << "NEW CATEGORY:" << std::endl << category << std::endl;
         };
 
@@ -72,32 +147,190 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             out << "CURRENT CATEGORY:" << std::endl << category << std::endl;
         };
 
-// exports category to file [FILE_NAME]
+// exports category to text file or binary file by extension [FILE_NAME]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::exportCategory =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
             std::string fileName = SafeSplit::nextName(arg, "file");
-            std::ofstream file(fileName);
-            Assert::assertIsOpen(file.is_open(), "category");
-            category.exportFull(file, true);
-            file.close();
+            SafeSplit::exportCategory(fileName, SafeSplit::isBinaryFile(fileName), &category);
             out << "NEW FILE:" << std::endl << fileName << std::endl;
         };
 
-// imports category from file [FILE_NAME]
+// imports category from text file or binary file by extension [FILE_NAME]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::importCategory =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
             std::string fileName = SafeSplit::nextName(arg, "file");
-            std::ifstream file(fileName);
-            Assert::assertIsOpen(file.is_open(), "category");
-            SpeedCategory::importFull(file, &category, true);
-            file.close();
+            detachJournal(interface, out);
+            SafeSplit::importCategory(fileName, SafeSplit::isBinaryFile(fileName), &category);
+            recordReplace(interface);
+            out << "NEW FILE:" << std::endl << fileName << std::endl;
+        };
+
+// exports category to binary file [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::exportCategoryBinary =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            SafeSplit::exportCategory(fileName, true, &category);
+            out << "NEW FILE:" << std::endl << fileName << std::endl;
+        };
+
+// imports category from binary file [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::importCategoryBinary =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            detachJournal(interface, out);
+            SafeSplit::importCategory(fileName, true, &category);
+            recordReplace(interface);
             out << "NEW FILE:" << std::endl << fileName << std::endl;
         };
 
+// maps binary category file and outputs summary without importing [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::viewCategory =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            CategoryView view(fileName);
+
+            CategorySummary summary;
+            summary.setName(std::string(view.getName()));
+            for (const TemplateView &splitTemplate: view.getTemplateSet())
+                summary.addTemplate(std::string(splitTemplate.name));
+            for (int i = 0; i < (int) view.getComparisonSet().size(); i++) summary.addComparison();
+            for (const PerformanceView &performance: view.getPerformanceSet()) {
+                const TemplateView &splitTemplate = view.getTemplateSet()[performance.templateIndex];
+                summary.addPerformance(std::string(splitTemplate.name), performance.splitSet.sum());
+            }
+            for (const PracticeView &practice: view.getPracticeSet()) {
+                const TemplateView &splitTemplate = view.getTemplateSet()[practice.templateIndex];
+                summary.addPractice(std::string(splitTemplate.name), practice.splitIndex, practice.time);
+            }
+
+            out << "VIEW CATEGORY:" << std::endl << summary;
+        };
+
+// streams category file by extension and outputs summary without importing [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::streamCategory =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            std::string fileName = SafeSplit::nextName(arg, "file");
+
+            CategorySummary summary;
+            CategoryVisitor visitor;
+            visitor.visitTemplate = [&summary](const SplitTemplate &v) { summary.addTemplate(v.getKey()); };
+            visitor.visitComparison = [&summary](const SplitComparison &v) { summary.addComparison(); };
+            visitor.visitPerformance = [&summary](const SplitPerformance &v) {
+                summary.addPerformance(v.getSplitTemplate()->getKey(), v.sum());
+            };
+            visitor.visitPractice = [&summary](const SplitPractice &v) {
+                summary.addPractice(v.getSplitTemplate()->getKey(), v.getSplitIndex(), v.getTime());
+            };
+
+            SpeedCategory category;
+            SafeSplit::streamCategory(fileName, SafeSplit::isBinaryFile(fileName), &category, visitor);
+            summary.setName(category.getKey());
+            out << "STREAM CATEGORY:" << std::endl << summary;
+        };
+
+// checks checksums of binary category file or archive without importing [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::verifyCategory =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            int checkedCount = SafeSplit::verifyCategory(fileName);
+            out << "VERIFY CATEGORY:" << std::endl << fileName << std::endl << checkedCount << " CHECKED" << std::endl;
+        };
+
+// exports category to compressed archive [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::exportArchive =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            CategoryArchive::exportArchive(fileName, &category);
+            out << "NEW FILE:" << std::endl << fileName << std::endl;
+        };
+
+// imports category from compressed archive [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::importArchive =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            detachJournal(interface, out);
+            CategoryArchive(fileName).importArchive(&category);
+            recordReplace(interface);
+            out << "NEW FILE:" << std::endl << fileName << std::endl;
+        };
+
+// exports entries changed after generation to delta file and outputs current generation [FILE_NAME] [GENERATION]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::exportDelta =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            std::uint64_t generation = SafeSplit::nextGeneration(arg, "delta");
+            generation = extractCategoryDelta(interface)->exportDelta(fileName, &category, generation);
+            out << "NEW FILE:" << std::endl << fileName << std::endl << generation << std::endl;
+        };
+
+// applies delta file to category and outputs generation it brings category to [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::importDelta =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            std::uint64_t generation = CategoryDelta::importDelta(fileName, &category);
+            recordImport(interface);
+            out << "NEW FILE:" << std::endl << fileName << std::endl << generation << std::endl;
+        };
+
+// outputs generation of latest change to working category []
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputGeneration =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            out << "CURRENT GENERATION:" << std::endl << extractCategoryDelta(interface)->getGeneration() << std::endl;
+        };
+
+// opens journal and loads its snapshot and records into category [FILE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::openJournal =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            CategoryJournal &journal = *extractCategoryJournal(interface);
+            std::string fileName = SafeSplit::nextName(arg, "journal");
+            journal.open(fileName, &category);
+            extractCategoryDelta(interface)->markNew();
+            out << "OPEN JOURNAL:" << std::endl << journal.getSnapshotName() << std::endl << category << std::endl;
+        };
+
+// writes category to journal snapshot and truncates journal []
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::compactJournal =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            CategoryJournal &journal = *extractCategoryJournal(interface);
+            Assert::assertIsOpen(journal.isOpen(), "journal");
+            journal.compact();
+            out << "COMPACT JOURNAL:" << std::endl << journal.getSnapshotName() << std::endl;
+        };
+
+// closes journal without further recording []
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::closeJournal =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            CategoryJournal &journal = *extractCategoryJournal(interface);
+            Assert::assertIsOpen(journal.isOpen(), "journal");
+            std::string snapshotName = journal.getSnapshotName();
+            journal.close();
+            out << "CLOSE JOURNAL:" << std::endl << snapshotName << std::endl;
+        };
+
 // creates new split template [TEMPLATE_NAME SPLIT_COUNT]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::newTemplate =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
@@ -107,6 +340,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             int size = SafeSplit::nextSize(arg, "template");
             SplitTemplate splitTemplate = SafeSplit::newSplitTemplate(name, size, &category);
             category.getSplitTemplateSet().addValue(splitTemplate);
+            recordPut(interface, splitTemplate);
             out << "NEW TEMPLATE:" << std::endl << splitTemplate << std::endl;
         };
 
@@ -120,6 +354,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             SplitTemplate splitTemplate = SafeSplit::newSplitTemplate(name, size, &category);
             SafeSplit::fillSplitTemplate(arg, &splitTemplate);
             category.getSplitTemplateSet().addValue(splitTemplate);
+            recordPut(interface, splitTemplate);
             out << "NEW TEMPLATE:" << std::endl << splitTemplate << std::endl;
         };
 
@@ -131,6 +366,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             std::string name = SafeSplit::nextName(arg, "template");
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
             SafeSplit::fillSplitTemplate(arg, &splitTemplate);
+            recordPut(interface, splitTemplate);
             out << "RENAME TEMPLATE:" << std::endl << splitTemplate << std::endl;
         };
 
@@ -144,6 +380,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             int index = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "template split");
             std::string newName = SafeSplit::nextName(arg, "template split");
             splitTemplate.getSet()[index] = Name(newName);
+            recordPut(interface, splitTemplate);
             out << "RENAME TEMPLATE:" << std::endl << splitTemplate << std::endl;
         };
 
@@ -157,6 +394,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitTemplate &splitTemplateSource = *SafeSplit::getSplitTemplate(nameSource, &category);
             const SplitTemplate &splitTemplateDestination = *SafeSplit::getSplitTemplate(nameDestination, &category);
             SafeSplit::copySplitTemplate(&splitTemplateSource, &splitTemplateDestination);
+            recordPut(interface, splitTemplateDestination);
             out << "SOURCE TEMPLATE:" << std::endl << splitTemplateSource << std::endl;
             out << "DESTINATION TEMPLATE:" << std::endl << splitTemplateDestination << std::endl;
         };
@@ -186,6 +424,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             SpeedCategory &category = *extractSpeedCategory(interface);
             std::string name = SafeSplit::nextName(arg, "template");
             SplitTemplate splitTemplate = SafeSplit::removeSplitTemplate(name, &category);
+            recordDelete(interface, splitTemplate);
             out << "DELETE TEMPLATE:" << std::endl << splitTemplate << std::endl;
         };
 
@@ -199,6 +438,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
             SplitComparison splitComparison = SafeSplit::newSplitComparison(comparisonName, &splitTemplate);
             category.getSplitComparisonSet().addValue(splitComparison);
+            recordPut(interface, splitComparison);
             out << "NEW COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
         };
 
@@ -213,6 +453,31 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             SplitComparison splitComparison = SafeSplit::newSplitComparison(comparisonName, &splitTemplate);
             SafeSplit::fillSplitComparison(arg, &splitComparison);
             category.getSplitComparisonSet().addValue(splitComparison);
+            recordPut(interface, splitComparison);
+            out << "NEW COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
+        };
+
+// create new split comparison averaging all performances of template [COMPARISON_NAME TEMPLATE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::newComparisonFromAverage =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string comparisonName = SafeSplit::nextName(arg, "comparison");
+            std::string templateName = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
+            SplitComparison splitComparison = SafeSplit::newSplitComparison(comparisonName, &splitTemplate);
+
+            const MomentMap<SplitPerformance> &map = category.getSplitPerformanceSet();
+            const std::vector<Moment> &momentSet =
+                    category.getTemplateIndex().getPerformanceMoments(category, splitTemplate.getKey());
+            std::vector<const IntervalSet *> performanceSet;
+            for (const Moment &moment: momentSet) performanceSet.push_back(&map.getValue(moment));
+            int performanceCount = Assert::assertPositive((int) performanceSet.size(), "performance count");
+            splitComparison += IntervalSet::sumAcross(performanceSet, splitTemplate.getSize());
+            splitComparison /= performanceCount;
+
+            category.getSplitComparisonSet().addValue(splitComparison);
+            recordPut(interface, splitComparison);
             out << "NEW COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
         };
 
@@ -225,6 +490,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitComparison &splitComparison = *SafeSplit::getSplitComparison(name, &category);
             const SplitTemplate &splitTemplate = *splitComparison.getSplitTemplate();
             SafeSplit::fillSplitComparison(arg, &splitComparison);
+            recordPut(interface, splitComparison);
             out << "RETIME COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
         };
 
@@ -239,6 +505,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             int index = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "comparison split");
             Period newTime = SafeSplit::nextTime(arg, "comparison split");
             splitComparison.getSet()[index] = newTime;
+            recordPut(interface, splitComparison);
             out << "RETIME COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
         };
 
@@ -256,6 +523,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitTemplate &splitTemplateSource = *splitComparisonSource.getSplitTemplate();
             const SplitTemplate &splitTemplateDestination = *splitComparisonDestination.getSplitTemplate();
             SafeSplit::copySplitComparison(&splitComparisonSource, &splitComparisonDestination);
+            recordPut(interface, splitComparisonDestination);
             out <<
                     "SOURCE COMPARISON:" << std::endl <<
                     splitTemplateSource << std::endl <<
@@ -293,6 +561,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             std::string name = SafeSplit::nextName(arg, "comparison");
             SplitComparison splitComparison = SafeSplit::removeSplitComparison(name, &category);
             const SplitTemplate &splitTemplate = *splitComparison.getSplitTemplate();
+            recordDelete(interface, splitComparison);
             out << "DELETE COMPARISON:" << std::endl << splitTemplate << std::endl << splitComparison << std::endl;
         };
 
@@ -301,11 +570,13 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            Moment performanceMoment = SafeSplit::nextMoment(arg, "performance");
+            Moment performanceMoment =
+                    SafeSplit::nextMoment(arg, "performance", category.getSplitPerformanceSet().getLastKey());
             std::string templateName = SafeSplit::nextName(arg, "template");
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
             SplitPerformance splitPerformance = SafeSplit::newSplitPerformance(performanceMoment, &splitTemplate);
-            category.getSplitPerformanceSet().addValue(splitPerformance);
+            SafeSplit::addSplitPerformance(splitPerformance, &category);
+            recordPut(interface, splitPerformance);
             out << "NEW PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
@@ -314,12 +585,14 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            Moment performanceMoment = SafeSplit::nextMoment(arg, "performance");
+            Moment performanceMoment =
+                    SafeSplit::nextMoment(arg, "performance", category.getSplitPerformanceSet().getLastKey());
             std::string templateName = SafeSplit::nextName(arg, "template");
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
             SplitPerformance splitPerformance = SafeSplit::newSplitPerformance(performanceMoment, &splitTemplate);
             SafeSplit::fillSplitPerformance(arg, &splitPerformance);
-            category.getSplitPerformanceSet().addValue(splitPerformance);
+            SafeSplit::addSplitPerformance(splitPerformance, &category);
+            recordPut(interface, splitPerformance);
             out << "NEW PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
@@ -332,6 +605,8 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitPerformance &splitPerformance = *SafeSplit::getSplitPerformance(moment, &category);
             const SplitTemplate &splitTemplate = *splitPerformance.getSplitTemplate();
             SafeSplit::fillSplitPerformance(arg, &splitPerformance);
+            SafeSplit::touchSplitPerformance(&splitPerformance, &category);
+            recordPut(interface, splitPerformance);
             out << "RETIME PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
@@ -346,6 +621,8 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             int index = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "performance split");
             Period newTime = SafeSplit::nextTime(arg, "performance split");
             splitPerformance.getSet()[index] = newTime;
+            SafeSplit::touchSplitPerformance(&splitPerformance, &category);
+            recordPut(interface, splitPerformance);
             out << "RETIME PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
@@ -363,6 +640,8 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitTemplate &splitTemplateSource = *splitPerformanceSource.getSplitTemplate();
             const SplitTemplate &splitTemplateDestination = *splitPerformanceDestination.getSplitTemplate();
             SafeSplit::copySplitPerformance(&splitPerformanceSource, &splitPerformanceDestination);
+            SafeSplit::touchSplitPerformance(&splitPerformanceDestination, &category);
+            recordPut(interface, splitPerformanceDestination);
             out <<
                     "SOURCE PERFORMANCE:" << std::endl <<
                     splitTemplateSource << std::endl <<
@@ -378,7 +657,67 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            out << "CURRENT PERFORMANCE:" << std::endl << category.getSplitPerformanceSet();
+            TextWriter writer(&out);
+            writer << "CURRENT PERFORMANCE:" << '\n' << category.getSplitPerformanceSet();
+        };
+
+// output split performances with moment from start to end, both included [START_MOMENT END_MOMENT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPerformancesBetween =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            Moment start = SafeSplit::nextMoment(arg, "start");
+            Moment end = SafeSplit::nextMoment(arg, "end");
+            TextWriter writer(&out);
+            writer << "PERFORMANCE BETWEEN:" << '\n' << category.getSplitPerformanceSet().getRange(start, end);
+        };
+
+// output split performances on days from first to last, both included [FIRST_DATE LAST_DATE]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPerformancesOnDays =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            Date first = SafeSplit::nextDate(arg, "first");
+            Date last = SafeSplit::nextDate(arg, "last");
+            TextWriter writer(&out);
+            writer << "PERFORMANCE ON DAYS:" << '\n' << category.getSplitPerformanceSet().getRange(first, last);
+        };
+
+// output split performances of template through template index [TEMPLATE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPerformancesOfTemplate =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string name = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
+            const MomentMap<SplitPerformance> &map = category.getSplitPerformanceSet();
+            TextWriter writer(&out);
+            writer << "TEMPLATE PERFORMANCE:" << '\n' << splitTemplate << '\n';
+            for (const Moment &moment: category.getTemplateIndex().getPerformanceMoments(category, splitTemplate.getKey()))
+                writer << map.getValue(moment) << '\n';
+        };
+
+// output count, best and average total of template performances by day, week or month [UNIT TEMPLATE_NAME]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPerformanceBuckets =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            CalendarBucket::Unit unit = SafeSplit::nextUnit(arg, "bucket");
+            std::string name = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
+            const std::vector<Moment> &momentSet =
+                    category.getTemplateIndex().getPerformanceMoments(category, splitTemplate.getKey());
+
+            std::vector<int> bucketSet(momentSet.size());
+            std::vector<Period> timeSet;
+            timeSet.reserve(momentSet.size());
+            CalendarBucket::bucket(momentSet.data(), momentSet.size(), unit, bucketSet.data());
+            for (const Moment &moment: momentSet)
+                timeSet.push_back(category.getSplitPerformanceSet().getValue(moment).sum());
+
+            out << "PERFORMANCE BUCKETS:" << std::endl << splitTemplate << std::endl;
+            for (const auto &it: CalendarBucket::summarize(bucketSet.data(), timeSet.data(), bucketSet.size()))
+                out << CalendarBucket::firstDay(it.first, unit) << " " << it.second << std::endl;
         };
 
 // output single split performance in category [PERFORMANCE_MOMENT]
@@ -392,6 +731,40 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             out << "CURRENT PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
+// output single split performance decoded from its archive block [FILE_NAME] [PERFORMANCE_MOMENT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputAtArchivedPerformance =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            Moment moment = SafeSplit::nextMoment(arg, "performance");
+            CategoryArchive archive(fileName);
+            SplitPerformance splitPerformance = archive.findPerformance(moment);
+            const SplitTemplate &splitTemplate = *splitPerformance.getSplitTemplate();
+            out << "ARCHIVED PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
+        };
+
+// outputs count, best, average and percentile of split across performances of template
+// [TEMPLATE_NAME SPLIT_INDEX PERCENTILE]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputSplitStatistics =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string name = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
+            int index = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "template split");
+            int percent = SafeSplit::nextIndex(101, arg, "percentile");
+
+            const PerformanceColumn *found =
+                    category.getPerformanceColumns().getColumn(category, splitTemplate.getKey());
+            PerformanceColumn empty(splitTemplate.getSize());
+            const PerformanceColumn &column = found ? *found : empty;
+            out <<
+                    "SPLIT STATISTICS:" << std::endl <<
+                    splitTemplate << std::endl <<
+                    splitTemplate.getSet()[index] << " " << column.getCount() << " " << column.best(index) << " " <<
+                    column.average(index) << " " << column.percentile(index, percent) << std::endl;
+        };
+
 // delete split performance in category [PERFORMANCE_MOMENT]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::deletePerformance =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
@@ -400,6 +773,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             Moment moment = SafeSplit::nextMoment(arg, "performance");
             SplitPerformance splitPerformance = SafeSplit::removeSplitPerformance(moment, &category);
             const SplitTemplate &splitTemplate = *splitPerformance.getSplitTemplate();
+            recordDelete(interface, splitPerformance);
             out << "DELETE PERFORMANCE:" << std::endl << splitTemplate << std::endl << splitPerformance << std::endl;
         };
 
@@ -408,12 +782,14 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            Moment practiceMoment = SafeSplit::nextMoment(arg, "practice");
+            Moment practiceMoment =
+                    SafeSplit::nextMoment(arg, "practice", category.getSplitPracticeSet().getLastKey());
             std::string templateName = SafeSplit::nextName(arg, "template");
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
             int splitIndex = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "practice split");
             SplitPractice splitPractice = SafeSplit::newSplitPractice(splitIndex, practiceMoment, &splitTemplate);
-            category.getSplitPracticeSet().addValue(splitPractice);
+            SafeSplit::addSplitPractice(splitPractice, &category);
+            recordPut(interface, splitPractice);
             out << "NEW PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
         };
 
@@ -422,13 +798,15 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            Moment practiceMoment = SafeSplit::nextMoment(arg, "practice");
+            Moment practiceMoment =
+                    SafeSplit::nextMoment(arg, "practice", category.getSplitPracticeSet().getLastKey());
             std::string templateName = SafeSplit::nextName(arg, "template");
             const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(templateName, &category);
             int splitIndex = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "practice split");
             SplitPractice splitPractice = SafeSplit::newSplitPractice(splitIndex, practiceMoment, &splitTemplate);
             splitPractice.getTime() = SafeSplit::nextTime(arg, "practice");
-            category.getSplitPracticeSet().addValue(splitPractice);
+            SafeSplit::addSplitPractice(splitPractice, &category);
+            recordPut(interface, splitPractice);
             out << "NEW PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
         };
 
@@ -441,6 +819,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitPractice &splitPractice = *SafeSplit::getSplitPractice(moment, &category);
             const SplitTemplate &splitTemplate = *splitPractice.getSplitTemplate();
             splitPractice.getTime() = SafeSplit::nextTime(arg, "practice");
+            recordPut(interface, splitPractice);
             out << "RETIME PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
         };
 
@@ -458,6 +837,7 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             const SplitTemplate &splitTemplateSource = *splitPracticeSource.getSplitTemplate();
             const SplitTemplate &splitTemplateDestination = *splitPracticeDestination.getSplitTemplate();
             splitPracticeDestination.getTime() = splitPracticeSource.getTime();
+            recordPut(interface, splitPracticeDestination);
             out <<
                 "SOURCE PRACTICE:" << std::endl <<
                 splitTemplateSource << std::endl <<
@@ -473,7 +853,70 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
         [](std::istream &arg, std::ostream &out, Interface *interface) {
 
             SpeedCategory &category = *extractSpeedCategory(interface);
-            out << "CURRENT PRACTICE:" << std::endl << category.getSplitPracticeSet();
+            TextWriter writer(&out);
+            writer << "CURRENT PRACTICE:" << '\n' << category.getSplitPracticeSet();
+        };
+
+// output split practices with moment from start to end, both included [START_MOMENT END_MOMENT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPracticesBetween =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            Moment start = SafeSplit::nextMoment(arg, "start");
+            Moment end = SafeSplit::nextMoment(arg, "end");
+            TextWriter writer(&out);
+            writer << "PRACTICE BETWEEN:" << '\n' << category.getSplitPracticeSet().getRange(start, end);
+        };
+
+// output split practices on days from first to last, both included [FIRST_DATE LAST_DATE]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPracticesOnDays =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            Date first = SafeSplit::nextDate(arg, "first");
+            Date last = SafeSplit::nextDate(arg, "last");
+            TextWriter writer(&out);
+            writer << "PRACTICE ON DAYS:" << '\n' << category.getSplitPracticeSet().getRange(first, last);
+        };
+
+// output split practices of template split through template index [TEMPLATE_NAME SPLIT_INDEX]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPracticesOfTemplate =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            std::string name = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
+            int splitIndex = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "practice split");
+            const MomentMap<SplitPractice> &map = category.getSplitPracticeSet();
+            TextWriter writer(&out);
+            writer << "TEMPLATE PRACTICE:" << '\n' << splitTemplate << '\n';
+            for (const Moment &moment:
+                    category.getTemplateIndex().getPracticeMoments(category, splitTemplate.getKey(), splitIndex))
+                writer << map.getValue(moment) << '\n';
+        };
+
+// output count, best and average time of split practices by day, week or month [UNIT TEMPLATE_NAME SPLIT_INDEX]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputPracticeBuckets =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            SpeedCategory &category = *extractSpeedCategory(interface);
+            CalendarBucket::Unit unit = SafeSplit::nextUnit(arg, "bucket");
+            std::string name = SafeSplit::nextName(arg, "template");
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate(name, &category);
+            int splitIndex = SafeSplit::nextIndex(splitTemplate.getSize(), arg, "practice split");
+            const std::vector<Moment> &momentSet =
+                    category.getTemplateIndex().getPracticeMoments(category, splitTemplate.getKey(), splitIndex);
+
+            std::vector<int> bucketSet(momentSet.size());
+            std::vector<Period> timeSet;
+            timeSet.reserve(momentSet.size());
+            CalendarBucket::bucket(momentSet.data(), momentSet.size(), unit, bucketSet.data());
+            for (const Moment &moment: momentSet)
+                timeSet.push_back(category.getSplitPracticeSet().getValue(moment).getTime());
+
+            out << "PRACTICE BUCKETS:" << std::endl << splitTemplate << std::endl;
+            for (const auto &it: CalendarBucket::summarize(bucketSet.data(), timeSet.data(), bucketSet.size()))
+                out << CalendarBucket::firstDay(it.first, unit) << " " << it.second << std::endl;
         };
 
 // output single split practice in category [PRACTICE_MOMENT]
@@ -487,6 +930,18 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             out << "CURRENT PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
         };
 
+// output single split practice decoded from its archive block [FILE_NAME] [PRACTICE_MOMENT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::outputAtArchivedPractice =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            std::string fileName = SafeSplit::nextName(arg, "file");
+            Moment moment = SafeSplit::nextMoment(arg, "practice");
+            CategoryArchive archive(fileName);
+            SplitPractice splitPractice = archive.findPractice(moment);
+            const SplitTemplate &splitTemplate = *splitPractice.getSplitTemplate();
+            out << "ARCHIVED PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
+        };
+
 // delete split practice from category [PRACTICE_MOMENT]
 const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::deletePractice =
         [](std::istream &arg, std::ostream &out, Interface *interface) {
@@ -495,5 +950,310 @@ const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInte
             Moment moment = SafeSplit::nextMoment(arg, "practice");
             SplitPractice splitPractice = SafeSplit::removeSplitPractice(moment, &category);
             const SplitTemplate &splitTemplate = *splitPractice.getSplitTemplate();
+            recordDelete(interface, splitPractice);
             out << "DELETE PRACTICE:" << std::endl << splitTemplate << std::endl << splitPractice << std::endl;
         };
+
+// measures text import throughput of stream and scanner on synthetic category [PERFORMANCE_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkTextImport =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int performanceCount = SafeSplit::nextSize(arg, "benchmark performance");
+            SpeedCategory category;
+            Benchmark::fillCategory(&category, performanceCount, 20);
+            std::stringstream text;
+            category.exportFull(text, true);
+            std::string data = text.str();
+
+            double streamSeconds = Benchmark::timeAction([&data]() {
+                std::istringstream stream(data);
+                SpeedCategory result;
+                SpeedCategory::importFull(stream, &result, true);
+            });
+            double scannerSeconds = Benchmark::timeAction([&data]() {
+                TextScanner scanner(data.data(), data.data() + data.size());
+                SpeedCategory result;
+                SpeedCategory::importFull(scanner, &result, true);
+            });
+
+            out << "BENCHMARK TEXT IMPORT:" << std::endl << data.size() << " BYTES" << std::endl;
+            out << "STREAM " << Benchmark::megabytePerSecond(data.size(), streamSeconds) << " MB/S" << std::endl;
+            out << "SCANNER " << Benchmark::megabytePerSecond(data.size(), scannerSeconds) << " MB/S" << std::endl;
+        };
+
+// measures text export throughput of stream and buffered writer on synthetic category [PERFORMANCE_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkTextExport =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int performanceCount = SafeSplit::nextSize(arg, "benchmark performance");
+            SpeedCategory category;
+            Benchmark::fillCategory(&category, performanceCount, 20);
+            std::size_t byteCount = 0;
+
+            double streamSeconds = Benchmark::timeAction([&category, &byteCount]() {
+                std::ostringstream stream;
+                category.exportFull(stream, true);
+                byteCount = stream.str().size();
+            });
+            double writerSeconds = Benchmark::timeAction([&category]() {
+                std::ostringstream stream;
+                TextWriter writer(&stream);
+                category.exportFull(writer, true);
+            });
+
+            out << "BENCHMARK TEXT EXPORT:" << std::endl << byteCount << " BYTES" << std::endl;
+            out << "STREAM " << Benchmark::megabytePerSecond(byteCount, streamSeconds) << " MB/S" << std::endl;
+            out << "WRITER " << Benchmark::megabytePerSecond(byteCount, writerSeconds) << " MB/S" << std::endl;
+        };
+
+// measures resident memory over repeated creation and deletion of performances and comparisons [CYCLE_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkMemoryCycle =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int cycleCount = SafeSplit::nextSize(arg, "benchmark cycle");
+            SpeedCategory category;
+            Benchmark::fillCategory(&category, 0, 20);
+            const SplitTemplate &splitTemplate = *SafeSplit::getSplitTemplate("Route", &category);
+            Moment moment(Date(0, 0, 2020), Period(0));
+
+            auto cycle = [&category, &splitTemplate, &moment]() {
+                SplitPerformance splitPerformance = SafeSplit::newSplitPerformance(moment, &splitTemplate);
+                SafeSplit::addSplitPerformance(splitPerformance, &category);
+                SafeSplit::removeSplitPerformance(moment, &category);
+
+                SplitComparison splitComparison = SafeSplit::newSplitComparison("Cycle", &splitTemplate);
+                category.getSplitComparisonSet().addValue(splitComparison);
+                SafeSplit::removeSplitComparison("Cycle", &category);
+            };
+
+            int warmCount = std::min(cycleCount, 1000);
+            for (int i = 0; i < warmCount; i++) cycle();
+            long startKilobyte = Benchmark::residentKilobyte();
+            double seconds = Benchmark::timeAction([&cycle, cycleCount, warmCount]() {
+                for (int i = warmCount; i < cycleCount; i++) cycle();
+            });
+            long endKilobyte = Benchmark::residentKilobyte();
+
+            out << "BENCHMARK MEMORY CYCLE:" << std::endl << cycleCount << " CYCLES" << std::endl;
+            out << "START " << startKilobyte << " KB" << std::endl;
+            out << "END " << endKilobyte << " KB" << std::endl;
+            out << "RATE " << (seconds > 0 ? (cycleCount - warmCount) / seconds : 0) << " CYCLES/S" << std::endl;
+        };
+
+// measures binary import and release of synthetic category with arena chunks and reserved storage [PERFORMANCE_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkCategoryArena =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int performanceCount = SafeSplit::nextSize(arg, "benchmark performance");
+            std::string data;
+            {
+                SpeedCategory category;
+                Benchmark::fillCategory(&category, performanceCount, 20);
+                BinaryWriter writer;
+                category.exportBinary(writer, true);
+                std::ostringstream stream;
+                writer.writeTo(stream);
+                data = stream.str();
+            }
+
+            SpeedCategory result;
+            double importSeconds = Benchmark::timeAction([&data, &result]() {
+                std::vector<NameView> nameTable;
+                BinaryReader reader(data.data(), data.data() + data.size());
+                reader.readHeader(&nameTable);
+                SpeedCategory::importBinary(reader, &result, true);
+            });
+            const CategoryArena &templateArena = result.getSplitTemplateSet().getArena();
+            const CategoryArena &comparisonArena = result.getSplitComparisonSet().getArena();
+            int chunkCount = templateArena.getChunkCount() + comparisonArena.getChunkCount();
+            std::size_t reservedByte = templateArena.getReservedByte() + comparisonArena.getReservedByte() +
+                                       result.getSplitPerformanceSet().getMap().capacity() * sizeof(SplitPerformance) +
+                                       result.getSplitPracticeSet().getMap().capacity() * sizeof(SplitPractice);
+            double releaseSeconds = Benchmark::timeAction([&result]() { result = SpeedCategory(); });
+
+            out << "BENCHMARK CATEGORY ARENA:" << std::endl << data.size() << " BYTES" << std::endl;
+            out << "IMPORT " << importSeconds << " S" << std::endl;
+            out << "RELEASE " << releaseSeconds << " S" << std::endl;
+            out << chunkCount << " CHUNKS " << reservedByte / 1024 << " KB" << std::endl;
+        };
+
+// measures average of single split across performances by map traversal and by column scan [PERFORMANCE_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkSplitScan =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int performanceCount = SafeSplit::nextSize(arg, "benchmark performance");
+            SpeedCategory category;
+            Benchmark::fillCategory(&category, performanceCount, 20);
+            const PerformanceColumn &column = *category.getPerformanceColumns().getColumn(category, Name("Route"));
+            const int repeatCount = 20;
+            std::size_t byteCount = sizeof(long long) * (std::size_t) performanceCount * repeatCount;
+
+            Period mapAverage(0);
+            double mapSeconds = Benchmark::timeAction([&category, &mapAverage, performanceCount]() {
+                for (int i = 0; i < repeatCount; i++) {
+                    Period sum(0);
+                    category.getSplitPerformanceSet().forEach([&sum](const SplitPerformance &v) {
+                        sum += v.getSet()[7];
+                    });
+                    mapAverage = sum / performanceCount;
+                }
+            });
+            Period columnAverage(0);
+            double columnSeconds = Benchmark::timeAction([&column, &columnAverage]() {
+                for (int i = 0; i < repeatCount; i++) columnAverage = column.average(7);
+            });
+
+            out << "BENCHMARK SPLIT SCAN:" << std::endl << mapAverage << " " << columnAverage << std::endl;
+            out << "MAP " << Benchmark::megabytePerSecond(byteCount, mapSeconds) << " MB/S" << std::endl;
+            out << "COLUMN " << Benchmark::megabytePerSecond(byteCount, columnSeconds) << " MB/S" << std::endl;
+        };
+
+// benchmarks interval set arithmetic, period by period against kernels, and sums of many sets [SPLIT_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkIntervalKernel =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int splitCount = SafeSplit::nextSize(arg, "benchmark split");
+            IntervalSet a(splitCount), b(splitCount);
+            for (int i = 0; i < splitCount; i++) {
+                a.getSet()[i] = Period::fromMicrosecondCount(30000000 + (long long) i % 7919 * 1000);
+                b.getSet()[i] = Period::fromMicrosecondCount(20000000 + (long long) i % 104729);
+            }
+            const int repeatCount = 20;
+            std::size_t byteCount = sizeof(Period) * (std::size_t) splitCount * repeatCount * 4;
+
+            IntervalSet periodResult(splitCount);
+            Period periodSum(0);
+            double periodSeconds = Benchmark::timeAction([&a, &b, &periodResult, &periodSum, splitCount]() {
+                for (int i = 0; i < repeatCount; i++) {
+                    for (int j = 0; j < splitCount; j++) periodResult.getSet()[j] = a.getSet()[j] + b.getSet()[j];
+                    for (int j = 0; j < splitCount; j++) periodResult.getSet()[j] = periodResult.getSet()[j] * 0.5;
+                    periodSum = std::accumulate(periodResult.getSet(), periodResult.getSet() + splitCount, Period(0));
+                }
+            });
+            IntervalSet kernelResult(splitCount);
+            Period kernelSum(0);
+            double kernelSeconds = Benchmark::timeAction([&a, &b, &kernelResult, &kernelSum]() {
+                for (int i = 0; i < repeatCount; i++) {
+                    kernelResult = a + b;
+                    kernelResult *= 0.5;
+                    kernelSum = kernelResult.sum();
+                }
+            });
+
+            IntervalSet expressionResult(splitCount);
+            Period expressionSum(0);
+            double expressionSeconds = Benchmark::timeAction([&a, &b, &expressionResult, &expressionSum]() {
+                for (int i = 0; i < repeatCount; i++) {
+                    expressionResult = (a + b) * 0.5;
+                    expressionSum = expressionResult.sum();
+                }
+            });
+
+            const int setCount = 16;
+            std::vector<IntervalSet> setSet;
+            std::vector<const IntervalSet *> pointerSet;
+            for (int i = 0; i < setCount; i++) setSet.push_back(i % 2 ? a : b);
+            for (const IntervalSet &v: setSet) pointerSet.push_back(&v);
+            std::size_t acrossByteCount = sizeof(Period) * (std::size_t) splitCount * setCount * repeatCount;
+
+            Period eachSum(0);
+            double eachSeconds = Benchmark::timeAction([&pointerSet, &eachSum, splitCount]() {
+                for (int i = 0; i < repeatCount; i++) {
+                    IntervalSet total(splitCount);
+                    for (const IntervalSet *v: pointerSet) total += *v;
+                    eachSum = total.sum();
+                }
+            });
+            Period acrossSum(0);
+            double acrossSeconds = Benchmark::timeAction([&pointerSet, &acrossSum, splitCount]() {
+                for (int i = 0; i < repeatCount; i++) acrossSum = IntervalSet::sumAcross(pointerSet, splitCount).sum();
+            });
+
+            out << "BENCHMARK INTERVAL KERNEL " << IntervalKernel::getLevel() << ":" << std::endl
+                << periodSum << " " << kernelSum << " " << expressionSum << std::endl
+                << eachSum << " " << acrossSum << std::endl;
+            out << "PERIOD " << Benchmark::megabytePerSecond(byteCount, periodSeconds) << " MB/S" << std::endl;
+            out << "KERNEL " << Benchmark::megabytePerSecond(byteCount, kernelSeconds) << " MB/S" << std::endl;
+            out << "EXPRESSION " << Benchmark::megabytePerSecond(byteCount, expressionSeconds) << " MB/S" << std::endl;
+            out << "EACH " << Benchmark::megabytePerSecond(acrossByteCount, eachSeconds) << " MB/S" << std::endl;
+            out << "ACROSS " << Benchmark::megabytePerSecond(acrossByteCount, acrossSeconds) << " MB/S" << std::endl;
+        };
+
+// measures per call cost of formatting periods, dates and moments into buffer, string and printf [CALL_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkTimeFormat =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int callCount = SafeSplit::nextSize(arg, "benchmark call");
+            Moment start(Date(0, 0, 2020), Period(0));
+            std::size_t charCount = 0;
+
+            auto period = [](int i) { return Period::fromMicrosecondCount(i * 7919LL * 100000 % 36000000000LL); };
+            auto moment = [start](int i) { return Moment(start.getSecondCount() + 3607LL * i); };
+
+            double printfSeconds = Benchmark::timeAction([&charCount, &period, callCount]() {
+                for (int i = 0; i < callCount; i++) {
+                    Period value = period(i);
+                    std::stringstream format;
+                    format << "%02d" << Period::componentDelimiter << "%02d" << Period::componentDelimiter << "%04.1f";
+                    char result[Period::bufferCharCount];
+                    snprintf(result, sizeof result, format.str().c_str(),
+                             value.hourInAllCount(), value.minuteInHourCount(), value.secondInMinuteCount());
+                    charCount += std::string(result).size();
+                }
+            });
+            double stringSeconds = Benchmark::timeAction([&charCount, &period, callCount]() {
+                for (int i = 0; i < callCount; i++) charCount += period(i).operator std::string().size();
+            });
+            double periodSeconds = Benchmark::timeAction([&charCount, &period, callCount]() {
+                char result[Period::bufferCharCount];
+                for (int i = 0; i < callCount; i++) charCount += period(i).format(result);
+            });
+            double dateSeconds = Benchmark::timeAction([&charCount, &moment, callCount]() {
+                char result[Date::bufferCharCount];
+                for (int i = 0; i < callCount; i++) charCount += moment(i).getDay().format(result);
+            });
+            double momentSeconds = Benchmark::timeAction([&charCount, &moment, callCount]() {
+                char result[Moment::bufferCharCount];
+                for (int i = 0; i < callCount; i++) charCount += moment(i).format(result);
+            });
+
+            std::size_t count = (std::size_t) callCount;
+            out << "BENCHMARK TIME FORMAT:" << std::endl << charCount << " CHARS" << std::endl;
+            out << "PERIOD PRINTF " << Benchmark::nanosecondPerCall(count, printfSeconds) << " NS" << std::endl;
+            out << "PERIOD STRING " << Benchmark::nanosecondPerCall(count, stringSeconds) << " NS" << std::endl;
+            out << "PERIOD BUFFER " << Benchmark::nanosecondPerCall(count, periodSeconds) << " NS" << std::endl;
+            out << "DATE BUFFER " << Benchmark::nanosecondPerCall(count, dateSeconds) << " NS" << std::endl;
+            out << "MOMENT BUFFER " << Benchmark::nanosecondPerCall(count, momentSeconds) << " NS" << std::endl;
+        };
+
+// measures per call cost of reading monotonic clock and issuing distinct keys against wall clock [CALL_COUNT]
+const std::function<void(std::istream &, std::ostream &, Interface *)> SplitInterface::benchmarkClock =
+        [](std::istream &arg, std::ostream &out, Interface *interface) {
+
+            int callCount = SafeSplit::nextSize(arg, "benchmark call");
+            long long total = 0;
+            int repeatCount = 0;
+
+            double wallSeconds = Benchmark::timeAction([&total, callCount]() {
+                for (int i = 0; i < callCount; i++) total += (long long) std::time(nullptr);
+            });
+            double nowSeconds = Benchmark::timeAction([&total, callCount]() {
+                for (int i = 0; i < callCount; i++) total += Clock::now().getMicrosecondCount();
+            });
+            double keySeconds = Benchmark::timeAction([&total, &repeatCount, callCount]() {
+                Moment last = Clock::nextKey();
+                for (int i = 0; i < callCount; i++) {
+                    Moment key = Clock::nextKey();
+                    repeatCount += key <= last;
+                    total += key.getMicrosecondCount();
+                    last = key;
+                }
+            });
+
+            std::size_t count = (std::size_t) callCount;
+            out << "BENCHMARK CLOCK:" << std::endl << (total != 0) << " CHECK" << std::endl;
+            out << repeatCount << " REPEATED KEYS" << std::endl;
+            out << "WALL SECOND " << Benchmark::nanosecondPerCall(count, wallSeconds) << " NS" << std::endl;
+            out << "CLOCK NOW " << Benchmark::nanosecondPerCall(count, nowSeconds) << " NS" << std::endl;
+            out << "CLOCK KEY " << Benchmark::nanosecondPerCall(count, keySeconds) << " NS" << std::endl;
+        };
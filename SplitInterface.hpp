@@ -1,5 +1,12 @@
 #pragma once
 #include <fstream>
+#include "Benchmark.hpp"
+#include "CategoryArchive.hpp"
+#include "CategoryDelta.hpp"
+#include "CategoryJournal.hpp"
+#include "CategorySummary.hpp"
+#include "CategoryView.hpp"
+#include "Clock.hpp"
 #include "Interface.hpp"
 #include "SafeSplit.hpp"
 
@@ -11,6 +18,12 @@ private:
     // current working category
     SpeedCategory speedCategory;
 
+    // journal of changes to working category
+    CategoryJournal categoryJournal;
+
+    // generation stamps of changes to working category
+    CategoryDelta categoryDelta;
+
 public:
 
     // constructor
@@ -23,12 +36,56 @@ public:
 
     static SpeedCategory *extractSpeedCategory(Interface *interface);
 
+    CategoryJournal *getCategoryJournal();
+
+    static CategoryJournal *extractCategoryJournal(Interface *interface);
+
+    CategoryDelta *getCategoryDelta();
+
+    static CategoryDelta *extractCategoryDelta(Interface *interface);
+
+    // record change to working category in journal and generation stamps
+
+    template<class V>
+    static void recordPut(Interface *interface, const V &value) {
+
+        extractCategoryJournal(interface)->recordPut(value);
+        extractCategoryDelta(interface)->markPut(value);
+    }
+
+    template<class V>
+    static void recordDelete(Interface *interface, const V &value) {
+
+        extractCategoryJournal(interface)->recordDelete(value);
+        extractCategoryDelta(interface)->markDelete(value);
+    }
+
+    static void recordReplace(Interface *interface);
+
+    static void recordImport(Interface *interface);
+
+    // close journal before working category is replaced by another category, leaving journal files as they are
+    static void detachJournal(Interface *interface, std::ostream &out);
+
     // operator
 
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newCategory;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> outputCategory;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> exportCategory;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> importCategory;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> exportCategoryBinary;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> importCategoryBinary;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> viewCategory;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> streamCategory;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> verifyCategory;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> openJournal;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> compactJournal;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> closeJournal;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> exportArchive;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> importArchive;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> exportDelta;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> importDelta;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputGeneration;
 
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newTemplate;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newTemplateWithSplits;
@@ -41,6 +98,7 @@ public:
 
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newComparison;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newComparisonWithSplits;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> newComparisonFromAverage;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> retimeComparisonAllSplits;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> retimeComparisonAtSplit;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> copyComparisonSplits;
@@ -54,14 +112,34 @@ public:
     static const std::function<void(std::istream &, std::ostream &, Interface *)> retimePerformanceAtSplit;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> copyPerformanceSplits;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAllPerformances;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPerformancesBetween;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPerformancesOnDays;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPerformancesOfTemplate;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPerformanceBuckets;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAtPerformance;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> deletePerformance;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAtArchivedPerformance;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputSplitStatistics;
 
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newPractice;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> newPracticeWithTime;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> retimePractice;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> copyPracticeTime;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAllPractices;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPracticesBetween;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPracticesOnDays;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPracticesOfTemplate;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputPracticeBuckets;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAtPractice;
     static const std::function<void(std::istream &, std::ostream &, Interface *)> deletePractice;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> outputAtArchivedPractice;
+
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkTextImport;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkTextExport;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkMemoryCycle;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkCategoryArena;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkSplitScan;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkIntervalKernel;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkTimeFormat;
+    static const std::function<void(std::istream &, std::ostream &, Interface *)> benchmarkClock;
 };
@@ -0,0 +1,9 @@
+#include <atomic>
+#include "SplitMap.hpp"
+
+static std::atomic<std::uint64_t> revisionCount(0);
+
+std::uint64_t MapRevision::next() {
+
+    return ++revisionCount;
+}
@@ -1,5 +1,10 @@
 #pragma once
+#include <climits>
+#include <iterator>
 #include <map>
+#include "CategoryArena.hpp"
+#include "FlatMap.hpp"
+#include "NameTable.hpp"
 #include "Time.hpp"
 
 // key wrapper for hash map
@@ -25,17 +30,24 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const HasMapKey &a) { return stream << a.key; }
+    template<class Out>
+    friend Out &operator<<(Out &stream, const HasMapKey &a) {
+
+        stream << a.key;
+        return stream;
+    }
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         if (newObject) key.exportFull(stream, true);
         return stream;
     }
 
-    static HasMapKey *importFull(std::istream &stream, HasMapKey *result, bool newObject) {
+    template<class In>
+    static HasMapKey *importFull(In &stream, HasMapKey *result, bool newObject) {
 
         if (newObject) {
             K k;
@@ -45,48 +57,122 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        if (newObject) key.exportBinary(writer, true);
+        return writer;
+    }
+
+    static HasMapKey *importBinary(BinaryReader &reader, HasMapKey *result, bool newObject) {
+
+        if (newObject) {
+            K k;
+            K::importBinary(reader, &k, true);
+            *result = HasMapKey(k);
+        }
+
+        return result;
+    }
+};
+
+// source of increasing stamps marking map changes
+class MapRevision {
+
+public:
+
+    // stamp greater than every stamp issued before, never 0
+    static std::uint64_t next();
 };
 
-// hash map wrapper for file io
-template<class K, class V>
-class MapInstance : public StreamIO<MapInstance<K, V>> {
+// hash map wrapper for file io, by default ordered map with nodes in arena of this map
+template<class K, class V, class M = std::map<K, V, std::less<K>, ArenaAllocator<std::pair<const K, V>>>>
+class MapInstance : public StreamIO<MapInstance<K, V, M>> {
 
 public:
 
+    typedef M Map;
+
     // value of map
-    std::map<K, V> map;
+    Map map;
+
+private:
+
+    // stamp of latest change to map
+    std::uint64_t revision;
 
 public:
 
+    // constructor
+
+    explicit MapInstance() : revision(MapRevision::next()) {}
+
     // map operation
 
     const V &getValue(const K &key) const { return map.find(key)->second; }
 
-    const V &addValue(const V &value) { return map.insert({value.getKey(), value}).first->second; }
+    const V &addValue(const V &value) {
+
+        revision = MapRevision::next();
+        return map.emplace(value.getKey(), value).first->second;
+    }
+
+    const V &addValue(V &&value) {
+
+        revision = MapRevision::next();
+        return map.emplace(value.getKey(), std::move(value)).first->second;
+    }
+
+    const V &putValue(const V &value) {
+
+        auto it = map.find(value.getKey());
+        if (it == map.end()) return addValue(value);
+        revision = MapRevision::next();
+        it->second = value;
+        return it->second;
+    }
 
     V delValue(const K &key) {
 
-        V value = getValue(key);
-        map.erase(key);
+        revision = MapRevision::next();
+        auto it = map.find(key);
+        V value = std::move(it->second);
+        map.erase(it);
         return value;
     }
 
+    // mark change made to values in place through their reference
+    void touch() { revision = MapRevision::next(); }
+
     // getter
 
-    const std::map<K, V> &getMap() const { return map; };
+    const Map &getMap() const { return map; };
+
+    std::uint64_t getRevision() const { return revision; }
+
+    // pass each value to callback in key order
+
+    template<class F>
+    void forEach(F callback) const {
+
+        for (const auto &it: map) callback(it.second);
+    }
 
     // transfer all to this map
 
-    void transfer(const MapInstance<K, V> &a) {
+    void transfer(const MapInstance &a) {
 
         for (const auto &it: a.map) addValue(it.second);
     }
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const MapInstance &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const MapInstance &a) {
 
-        for (const auto &it: a.map) stream << it.second << std::endl;
+        for (const auto &it: a.map) stream << it.second << '\n';
         return stream;
     }
 
@@ -98,7 +184,8 @@ public:
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         if (newObject) {
             stream << map.size() << " ";
@@ -108,23 +195,65 @@ public:
         return stream;
     }
 
-    static MapInstance *importFull(std::istream &stream, MapInstance *result, bool newObject) {
+    template<class In>
+    static MapInstance *importFull(In &stream, MapInstance *result, bool newObject) {
 
         if (newObject) {
-
-            int size;
-            stream >> size;
             *result = MapInstance();
+            importEach(stream, [result](V &v) { result->addValue(std::move(v)); });
+        }
+
+        return result;
+    }
+
+    // stream each value to callback without storing
+
+    template<class In, class F>
+    static void importEach(In &stream, F callback) {
+
+        int size = 0;
+        stream >> size;
+
+        for (int i = 0; i < size; i++) {
+            V v;
+            V::importFull(stream, &v, true);
+            callback(v);
+        }
+    }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        if (newObject) {
+            writer.writeU32((std::uint32_t) map.size());
+            for (const auto &it: map) it.second.exportBinary(writer, true);
+        }
+
+        return writer;
+    }
 
-            for (int i = 0; i < size; i++) {
-                V v;
-                V::importFull(stream, &v, true);
-                result->addValue(v);
-            }
+    static MapInstance *importBinary(BinaryReader &reader, MapInstance *result, bool newObject) {
+
+        if (newObject) {
+            *result = MapInstance();
+            importEachBinary(reader, [result](V &v) { result->addValue(std::move(v)); });
         }
 
         return result;
     }
+
+    template<class F>
+    static void importEachBinary(BinaryReader &reader, F callback) {
+
+        std::uint32_t size = reader.readCount();
+
+        for (std::uint32_t i = 0; i < size; i++) {
+            V v;
+            V::importBinary(reader, &v, true);
+            callback(v);
+        }
+    }
 };
 
 // name wrapper for hash key
@@ -140,11 +269,18 @@ public:
 
     // file io
 
-    static HasName *importFull(std::istream &stream, HasName *result, bool newObject) {
+    template<class In>
+    static HasName *importFull(In &stream, HasName *result, bool newObject) {
 
         HasMapKey::importFull(stream, result, newObject);
         return result;
     }
+
+    static HasName *importBinary(BinaryReader &reader, HasName *result, bool newObject) {
+
+        HasMapKey::importBinary(reader, result, newObject);
+        return result;
+    }
 };
 
 // moment wrapper for hash key
@@ -160,39 +296,190 @@ public:
 
     // file io
 
-    static HasMoment *importFull(std::istream &stream, HasMoment *result, bool newObject) {
+    template<class In>
+    static HasMoment *importFull(In &stream, HasMoment *result, bool newObject) {
 
         HasMapKey::importFull(stream, result, newObject);
         return result;
     }
+
+    static HasMoment *importBinary(BinaryReader &reader, HasMoment *result, bool newObject) {
+
+        HasMapKey::importBinary(reader, result, newObject);
+        return result;
+    }
+};
+
+// dense ids of map keys with value of each id, emptied rather than copied along with map
+template<class V>
+class NameIndex {
+
+public:
+
+    // interned keys and value of each id
+    NameTable nameTable;
+    std::vector<const V *> valueSet;
+
+    // revision of map index was built from, 0 if never built
+    std::uint64_t revision;
+
+    // constructor
+
+    explicit NameIndex() : revision(0) {}
+
+    NameIndex(const NameIndex &) : revision(0) {}
+
+    NameIndex &operator=(const NameIndex &) {
+
+        nameTable.clear();
+        valueSet.clear();
+        revision = 0;
+        return *this;
+    }
 };
 
 // hash map wrapper for name
 template<class V>
 class NamedMap : public MapInstance<Name, V> {
 
+private:
+
+    // id of each key, rebuilt on lookup after map changed
+    mutable NameIndex<V> index;
+
 public:
 
+    // rebuild id index if map changed since it was built, before sharing map between threads
+
+    void updateIndex() const {
+
+        if (index.revision == this->getRevision()) return;
+        index.nameTable.clear();
+        index.valueSet.clear();
+        for (const auto &it: this->getMap()) {
+            index.nameTable.intern(it.first);
+            index.valueSet.push_back(&it.second);
+        }
+        index.revision = this->getRevision();
+    }
+
+    // id of key without comparing strings, or -1
+
+    int findId(const char *data, std::size_t size) const {
+
+        updateIndex();
+        return index.nameTable.find(data, size);
+    }
+
+    const V &getValueById(int id) const { return *index.valueSet[id]; }
+
+    // arena holding map nodes, moment maps keeping their entries in one vector instead
+
+    const CategoryArena &getArena() const { return *this->map.get_allocator().arena; }
+
     // file io
 
-    static NamedMap *importFull(std::istream &stream, NamedMap *result, bool newObject) {
+    template<class In>
+    static NamedMap *importFull(In &stream, NamedMap *result, bool newObject) {
 
         MapInstance<Name, V>::importFull(stream, result, newObject);
         return result;
     }
+
+    static NamedMap *importBinary(BinaryReader &reader, NamedMap *result, bool newObject) {
+
+        MapInstance<Name, V>::importBinary(reader, result, newObject);
+        return result;
+    }
 };
 
-// hash map wrapper for moment
+// run of consecutive map entries, viewed in place without copying
+template<class I>
+class MapRange {
+
+private:
+
+    I first;
+    I last;
+
+public:
+
+    // constructor
+
+    explicit MapRange(I first, I last) : first(first), last(last) {}
+
+    // getter
+
+    I begin() const { return first; }
+
+    I end() const { return last; }
+
+    std::size_t size() const { return (std::size_t) std::distance(first, last); }
+
+    bool empty() const { return first == last; }
+
+    // pass each value to callback in key order
+
+    template<class F>
+    void forEach(F callback) const {
+
+        for (I it = first; it != last; ++it) callback(it->second);
+    }
+
+    // stream operator
+
+    template<class Out>
+    friend Out &operator<<(Out &stream, const MapRange &a) {
+
+        for (I it = a.first; it != a.last; ++it) stream << it->second << '\n';
+        return stream;
+    }
+};
+
+// sorted vector map wrapper for moment, as values mostly arrive in moment order
 template<class V>
-class MomentMap : public MapInstance<Moment, V> {
+class MomentMap : public MapInstance<Moment, V, FlatMap<Moment, V>> {
 
 public:
 
+    typedef MapRange<typename FlatMap<Moment, V>::const_iterator> Range;
+
+    // latest moment, or moment before every other when empty
+    Moment getLastKey() const {
+
+        return this->map.empty() ? Moment::fromMicrosecondCount(LLONG_MIN) : (this->map.end() - 1)->first;
+    }
+
+    // values with moment from first to last, both included
+
+    Range getRange(const Moment &first, const Moment &last) const {
+
+        auto begin = this->map.lower_bound(first);
+        auto end = this->map.upper_bound(last);
+        return Range(begin, std::max(begin, end));
+    }
+
+    // values with moment on any day from first to last, both included
+
+    Range getRange(const Date &first, const Date &last) const {
+
+        auto begin = this->map.lower_bound(Moment(first, Period(0)));
+        auto end = this->map.lower_bound(Moment(Date(last.dayInAllCount() + 1), Period(0)));
+        return Range(begin, std::max(begin, end));
+    }
+
     // file io
 
-    static MomentMap *importFull(std::istream &stream, MomentMap *result, bool newObject) {
+    template<class In>
+    static MomentMap *importFull(In &stream, MomentMap *result, bool newObject) {
+
+        MapInstance<Moment, V, FlatMap<Moment, V>>::importFull(stream, result, newObject);
+        return result;
+    }
+
+    static MomentMap *importBinary(BinaryReader &reader, MomentMap *result, bool newObject) {
 
-        MapInstance<Moment, V>::importFull(stream, result, newObject);
+        MapInstance<Moment, V, FlatMap<Moment, V>>::importBinary(reader, result, newObject);
         return result;
     }
 };
@@ -1,23 +1,124 @@
 #pragma once
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "Assertion.hpp"
+#include "IntervalKernel.hpp"
+#include "SetExpression.hpp"
 #include "Time.hpp"
 
-// pointer to array
+// uninitialized storage for count elements inside owning object
+template<class E, int count>
+class InlineStorage {
+
+private:
+
+    alignas(E) unsigned char byteSet[count * sizeof(E)];
+
+public:
+
+    E *get() { return reinterpret_cast<E *>(byteSet); }
+};
+
+// no inline storage, so object stays pointer sized
 template<class E>
-class PointerSet : public StreamIO<PointerSet<E>> {
+class InlineStorage<E, 0> {
+
+public:
+
+    E *get() { return nullptr; }
+};
+
+// owning array, stored inline when at most inline count elements
+template<class E, int inlineCount>
+class PointerSet : public StreamIO<PointerSet<E, inlineCount>> {
 
 private:
 
-    // indefinitely sized array
+    // indefinitely sized array, pointing into inline storage when small
     int size;
     E *set;
+    InlineStorage<E, inlineCount> inlineSet;
+
+    // point to storage for size elements without constructing them
+    void allocate() {
+
+        if (size <= inlineCount) set = inlineSet.get();
+        else set = static_cast<E *>(::operator new(sizeof(E) * size));
+    }
+
+    // destroy elements and free heap storage
+    void release() {
+
+        for (int i = 0; i < size; i++) set[i].~E();
+        if (size > inlineCount) ::operator delete(set);
+        size = 0;
+        set = inlineSet.get();
+    }
+
+    // take elements of array, stealing heap storage but moving inline elements
+    void take(PointerSet &&a) {
+
+        size = a.size;
+        if (size > inlineCount) {
+            set = a.set;
+        } else {
+            allocate();
+            for (int i = 0; i < size; i++) {
+                new(set + i) E(std::move(a.set[i]));
+                a.set[i].~E();
+            }
+        }
+        a.size = 0;
+        a.set = a.inlineSet.get();
+    }
 
 public:
 
     // constructor
 
-    explicit PointerSet() : size(0) {}
+    explicit PointerSet() : size(0), set(inlineSet.get()) {}
+
+    explicit PointerSet(int size) : size(size) {
+
+        allocate();
+        for (int i = 0; i < size; i++) new(set + i) E();
+    }
+
+    // deep copy
+    PointerSet(const PointerSet &a) : size(a.size) {
+
+        allocate();
+        for (int i = 0; i < size; i++) new(set + i) E(a.set[i]);
+    }
+
+    PointerSet(PointerSet &&a) noexcept { take(std::move(a)); }
 
-    explicit PointerSet(int size) : size(size), set(new E[size]) {}
+    PointerSet &operator=(const PointerSet &a) {
+
+        if (this != &a) {
+            if (size == a.size) {
+                std::copy(a.set, a.set + size, set);
+            } else {
+                release();
+                size = a.size;
+                allocate();
+                for (int i = 0; i < size; i++) new(set + i) E(a.set[i]);
+            }
+        }
+        return *this;
+    }
+
+    PointerSet &operator=(PointerSet &&a) noexcept {
+
+        if (this != &a) {
+            release();
+            take(std::move(a));
+        }
+        return *this;
+    }
+
+    ~PointerSet() { release(); }
 
     // getter
 
@@ -31,7 +132,8 @@ public:
 
     // stream operator
 
-    friend std::ostream &operator<<(std::ostream &stream, const PointerSet &a) {
+    template<class Out>
+    friend Out &operator<<(Out &stream, const PointerSet &a) {
 
         for (int i = 0; i < a.size; i++) stream << a.set[i] << " ";
         return stream;
@@ -45,14 +147,16 @@ public:
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
         if (newObject) stream << size << " ";
         for (int i = 0; i < size; i++) set[i].exportFull(stream, true);
         return stream;
     }
 
-    static PointerSet *importFull(std::istream &stream, PointerSet *result, bool newObject) {
+    template<class In>
+    static PointerSet *importFull(In &stream, PointerSet *result, bool newObject) {
 
         if (newObject) {
             int size;
@@ -67,10 +171,61 @@ public:
 
         return result;
     }
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        if (newObject) writer.writeU32((std::uint32_t) size);
+        for (int i = 0; i < size; i++) set[i].exportBinary(writer, true);
+        return writer;
+    }
+
+    static PointerSet *importBinary(BinaryReader &reader, PointerSet *result, bool newObject) {
+
+        if (newObject) *result = PointerSet((int) reader.readCount());
+
+        for (int i = 0; i < result->size; i++) {
+            E &e = result->set[i];
+            E::importBinary(reader, &e, true);
+        }
+
+        return result;
+    }
+};
+
+class IntervalSet;
+
+class NameSet;
+
+// sets are held by reference inside expressions
+template<>
+struct ExpressionOperand<IntervalSet> {
+
+    typedef const IntervalSet &type;
 };
 
+template<>
+struct ExpressionOperand<NameSet> {
+
+    typedef const NameSet &type;
+};
+
+// periods stored inline per set, covering typical split counts while keeping performances small to move
+static const int intervalInlineCount = 16;
+
 // pointer to array of period
-class IntervalSet : public PointerSet<Period> {
+class IntervalSet : public PointerSet<Period, intervalInlineCount>, public IntervalExpression<IntervalSet> {
+
+private:
+
+    // periods viewed as contiguous microsecond counts for kernels
+    static_assert(sizeof(Period) == sizeof(long long) && std::is_standard_layout<Period>::value,
+                  "period must be laid out as single microsecond count");
+
+    static long long *countOf(Period *a) { return reinterpret_cast<long long *>(a); }
+
+    static const long long *countOf(const Period *a) { return reinterpret_cast<const long long *>(a); }
 
 public:
 
@@ -80,11 +235,41 @@ public:
 
     explicit IntervalSet(int size) : PointerSet(size) {}
 
+    template<class E>
+    IntervalSet(const IntervalExpression<E> &a) : PointerSet(a.self().getSize()) { assign(a); }
+
+    // evaluation
+
+    const long long *evaluate(int start, int, long long *) const { return countOf(getSet() + start); }
+
+    // evaluate expression of same size into this set
+    template<class E>
+    const IntervalSet &assign(const IntervalExpression<E> &a) const {
+
+        // through separate block, as expression may read this set after writing its buffer
+        long long block[intervalBlockSize];
+        long long *result = countOf(getSet());
+        for (int start = 0; start < getSize(); start += intervalBlockSize) {
+            int size = std::min(intervalBlockSize, getSize() - start);
+            const long long *x = a.self().evaluate(start, size, block);
+            std::copy(x, x + size, result + start);
+        }
+        return *this;
+    }
+
+    template<class E>
+    IntervalSet &operator=(const IntervalExpression<E> &a) {
+
+        if (a.self().getSize() != getSize()) *this = IntervalSet(a);
+        else assign(a);
+        return *this;
+    }
+
     // summation
 
     Period sum(int start, int end) const {
 
-        return std::accumulate(getSet() + start, getSet() + end, Period(0));
+        return Period::fromMicrosecondCount(IntervalKernel::sum(countOf(getSet() + start), end - start));
     }
 
     Period sum() const { return sum(0, getSize()); }
@@ -98,75 +283,73 @@ public:
     IntervalSet prefixSum() const {
 
         IntervalSet result(getSize() + 1);
-        for (int i = 0; i < getSize(); i++) result.getSet()[i + 1] = result.getSet()[i] + getSet()[i];
+        IntervalKernel::prefixSum(countOf(getSet()), countOf(result.getSet() + 1), getSize());
         return result;
     }
 
-    // arithmetic operator
+    // extremum, zero when empty
 
-    IntervalSet operator+(const IntervalSet &a) const {
+    Period min() const {
 
-        IntervalSet result(getSize());
-        for (int i = 0; i < getSize(); i++) result.getSet()[i] = getSet()[i] + a.getSet()[i];
-        return result;
+        return getSize() ? Period::fromMicrosecondCount(IntervalKernel::min(countOf(getSet()), getSize())) : Period(0);
     }
 
-    IntervalSet operator-(const IntervalSet &a) const {
+    Period max() const {
 
-        IntervalSet result(getSize());
-        for (int i = 0; i < getSize(); i++) result.getSet()[i] = getSet()[i] - a.getSet()[i];
-        return result;
+        return getSize() ? Period::fromMicrosecondCount(IntervalKernel::max(countOf(getSet()), getSize())) : Period(0);
     }
 
-    IntervalSet operator*(double a) const {
+    // arithmetic operator, binary forms build expressions
 
-        IntervalSet result(getSize());
-        for (int i = 0; i < getSize(); i++) result.getSet()[i] = getSet()[i] * a;
-        return result;
-    }
+    template<class E>
+    const IntervalSet &operator+=(const IntervalExpression<E> &a) const {
 
-    IntervalSet operator/(double a) const {
-
-        IntervalSet result(getSize());
-        for (int i = 0; i < getSize(); i++) result.getSet()[i] = getSet()[i] / a;
-        return result;
+        return assign(IntervalJoin<IntervalSet, E, false>(*this, a.self()));
     }
 
-    const IntervalSet &operator+=(const IntervalSet &a) const {
+    template<class E>
+    const IntervalSet &operator-=(const IntervalExpression<E> &a) const {
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] += a.getSet()[i];
-        return *this;
+        return assign(IntervalJoin<IntervalSet, E, true>(*this, a.self()));
     }
 
-    const IntervalSet &operator-=(const IntervalSet &a) const {
-
-        for (int i = 0; i < getSize(); i++) getSet()[i] -= a.getSet()[i];
-        return *this;
-    }
+    const IntervalSet &operator*=(double a) const { return assign(IntervalScale<IntervalSet, false>(*this, a)); }
 
-    const IntervalSet &operator*=(double a) const {
+    const IntervalSet &operator/=(double a) const { return assign(IntervalScale<IntervalSet, true>(*this, a)); }
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] *= a;
-        return *this;
-    }
+    // sum of many sets of size, taken block by block so running totals stay in cache while every set passes
+    static IntervalSet sumAcross(const std::vector<const IntervalSet *> &setSet, int size) {
 
-    const IntervalSet &operator/=(double a) const {
+        for (const IntervalSet *a: setSet) Assert::assertRange(size, a->getSize() + 1, "interval set size");
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] /= a;
-        return *this;
+        IntervalSet result(size);
+        long long *total = countOf(result.getSet());
+        for (int start = 0; start < size; start += intervalBlockSize) {
+            std::size_t blockSize = (std::size_t) std::min(intervalBlockSize, size - start);
+            for (const IntervalSet *a: setSet)
+                IntervalKernel::add(total + start, countOf(a->getSet() + start), total + start, blockSize);
+        }
+        return result;
     }
 
     // file io
 
-    static IntervalSet *importFull(std::istream &stream, IntervalSet *result, bool newObject) {
+    template<class In>
+    static IntervalSet *importFull(In &stream, IntervalSet *result, bool newObject) {
 
         PointerSet::importFull(stream, result, newObject);
         return result;
     }
+
+    static IntervalSet *importBinary(BinaryReader &reader, IntervalSet *result, bool newObject) {
+
+        PointerSet::importBinary(reader, result, newObject);
+        return result;
+    }
 };
 
-// pointer to array of name
-class NameSet : public PointerSet<Name> {
+// pointer to array of name, always on heap as names are large and templates few
+class NameSet : public PointerSet<Name, 0>, public NameExpression<NameSet> {
 
 public:
 
@@ -186,69 +369,89 @@ public:
         std::fill(getSet(), getSet() + getSize(), Name(std::string(1, defaultName)));
     }
 
-    // arithmetic operator
+    template<class E>
+    NameSet(const NameExpression<E> &a) : PointerSet(a.self().getSize()) { assign(a); }
 
-    NameSet operator+(const NameSet &a) const {
+    // evaluation
 
-        NameSet result(getSize());
-        for (int i = 0; i < getSize(); i++)
-            result.getSet()[i] = Name(getSet()[i] + addOperator + a.getSet()[i]);
-        return result;
-    }
-
-    NameSet operator-(const NameSet &a) const {
-
-        NameSet result(getSize());
-        for (int i = 0; i < getSize(); i++)
-            result.getSet()[i] = Name(getSet()[i] + subtractOperator + a.getSet()[i]);
-        return result;
-    }
-
-    NameSet operator*(double a) const {
-
-        NameSet result(getSize());
-        for (int i = 0; i < getSize(); i++)
-            result.getSet()[i] = Name(getSet()[i] + multiplyOperator + std::to_string(a));
-        return result;
-    }
+    void appendName(int index, std::string *result) const { result->append(getSet()[index]); }
 
-    NameSet operator/(double a) const {
+    // evaluate expression of same size into this set
+    template<class E>
+    const NameSet &assign(const NameExpression<E> &a) const {
 
-        NameSet result(getSize());
-        for (int i = 0; i < getSize(); i++)
-            result.getSet()[i] = Name(getSet()[i] + divideOperator + std::to_string(a));
-        return result;
+        for (int i = 0; i < getSize(); i++) {
+            std::string name;
+            a.self().appendName(i, &name);
+            getSet()[i] = Name(std::move(name));
+        }
+        return *this;
     }
 
-    const NameSet &operator+=(const NameSet &a) const {
+    template<class E>
+    NameSet &operator=(const NameExpression<E> &a) {
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] += addOperator + a.getSet()[i];
+        if (a.self().getSize() != getSize()) *this = NameSet(a);
+        else assign(a);
         return *this;
     }
 
-    const NameSet &operator-=(const NameSet &a) const {
+    // arithmetic operator, binary forms build expressions
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] += subtractOperator + a.getSet()[i];
-        return *this;
+    template<class E>
+    const NameSet &operator+=(const NameExpression<E> &a) const {
+
+        return assign(NameJoin<NameSet, E>(*this, a.self(), addOperator));
     }
 
-    const NameSet &operator*=(double a) const {
+    template<class E>
+    const NameSet &operator-=(const NameExpression<E> &a) const {
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] += multiplyOperator + std::to_string(a);
-        return *this;
+        return assign(NameJoin<NameSet, E>(*this, a.self(), subtractOperator));
     }
 
-    const NameSet &operator/=(double a) const {
+    const NameSet &operator*=(double a) const { return assign(NameScale<NameSet>(*this, multiplyOperator, a)); }
 
-        for (int i = 0; i < getSize(); i++) getSet()[i] += divideOperator + std::to_string(a);
-        return *this;
-    }
+    const NameSet &operator/=(double a) const { return assign(NameScale<NameSet>(*this, divideOperator, a)); }
 
     // file io
 
-    static NameSet *importFull(std::istream &stream, NameSet *result, bool newObject) {
+    template<class In>
+    static NameSet *importFull(In &stream, NameSet *result, bool newObject) {
 
         PointerSet::importFull(stream, result, newObject);
         return result;
     }
+
+    static NameSet *importBinary(BinaryReader &reader, NameSet *result, bool newObject) {
+
+        PointerSet::importBinary(reader, result, newObject);
+        return result;
+    }
 };
+
+// name operator
+
+template<class L, class R>
+NameJoin<L, R> operator+(const NameExpression<L> &a, const NameExpression<R> &b) {
+
+    return NameJoin<L, R>(a.self(), b.self(), NameSet::addOperator);
+}
+
+template<class L, class R>
+NameJoin<L, R> operator-(const NameExpression<L> &a, const NameExpression<R> &b) {
+
+    return NameJoin<L, R>(a.self(), b.self(), NameSet::subtractOperator);
+}
+
+template<class E>
+NameScale<E> operator*(const NameExpression<E> &a, double b) {
+
+    return NameScale<E>(a.self(), NameSet::multiplyOperator, b);
+}
+
+template<class E>
+NameScale<E> operator/(const NameExpression<E> &a, double b) {
+
+    return NameScale<E>(a.self(), NameSet::divideOperator, b);
+}
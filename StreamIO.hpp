@@ -1,5 +1,8 @@
 #pragma once
 #include <iostream>
+#include "BinaryIO.hpp"
+#include "TextScanner.hpp"
+#include "TextWriter.hpp"
 
 // device for file io to stream
 template<class D>
@@ -15,12 +18,15 @@ public:
 
     // file io
 
-    virtual const std::ostream &exportFull(std::ostream &stream, bool newObject) const {
+    template<class Out>
+    const Out &exportFull(Out &stream, bool newObject) const {
 
-        return stream << *dThis() << " ";
+        stream << *dThis() << " ";
+        return stream;
     }
 
-    static D *importFull(std::istream &stream, D *result, bool newObject) {
+    template<class In>
+    static D *importFull(In &stream, D *result, bool newObject) {
 
         if (newObject) *result = D();
         stream >> *result;
@@ -38,4 +44,18 @@ public:
     explicit Name() : std::string() {}
 
     explicit Name(std::string a) : std::string(std::move(a)) {}
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const {
+
+        writer.writeName(*this);
+        return writer;
+    }
+
+    static Name *importBinary(BinaryReader &reader, Name *result, bool newObject) {
+
+        *result = Name(std::string(reader.readName()));
+        return result;
+    }
 };
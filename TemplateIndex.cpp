@@ -0,0 +1,111 @@
+#include <algorithm>
+#include "TemplateIndex.hpp"
+#include "Split.hpp"
+
+void TemplateIndex::insertMoment(std::vector<Moment> *momentSet, const Moment &moment) {
+
+    if (momentSet->empty() || momentSet->back() < moment) {
+        momentSet->push_back(moment);
+        return;
+    }
+
+    auto it = std::lower_bound(momentSet->begin(), momentSet->end(), moment);
+    if (*it != moment) momentSet->insert(it, moment);
+}
+
+void TemplateIndex::eraseMoment(std::vector<Moment> *momentSet, const Moment &moment) {
+
+    auto it = std::lower_bound(momentSet->begin(), momentSet->end(), moment);
+    if (it != momentSet->end() && *it == moment) momentSet->erase(it);
+}
+
+void TemplateIndex::update(const SpeedCategory &speedCategory) {
+
+    const MomentMap<SplitPerformance> &performanceMap = speedCategory.getSplitPerformanceSet();
+    if (performanceRevision != performanceMap.getRevision()) {
+        performanceSet.clear();
+        performanceMap.forEach([this](const SplitPerformance &v) {
+            performanceSet[v.getSplitTemplate()->getKey()].push_back(v.getKey());
+        });
+        performanceRevision = performanceMap.getRevision();
+    }
+
+    const MomentMap<SplitPractice> &practiceMap = speedCategory.getSplitPracticeSet();
+    if (practiceRevision != practiceMap.getRevision()) {
+        practiceSet.clear();
+        practiceMap.forEach([this](const SplitPractice &v) {
+            practiceSet[std::make_pair(v.getSplitTemplate()->getKey(), v.getSplitIndex())].push_back(v.getKey());
+        });
+        practiceRevision = practiceMap.getRevision();
+    }
+}
+
+TemplateIndex &TemplateIndex::operator=(const TemplateIndex &) {
+
+    performanceSet.clear();
+    practiceSet.clear();
+    performanceRevision = 0;
+    practiceRevision = 0;
+    return *this;
+}
+
+const std::vector<Moment> &TemplateIndex::getPerformanceMoments(
+        const SpeedCategory &speedCategory, const Name &templateName) {
+
+    static const std::vector<Moment> empty;
+
+    update(speedCategory);
+    auto it = performanceSet.find(templateName);
+    return it == performanceSet.end() ? empty : it->second;
+}
+
+const std::vector<Moment> &TemplateIndex::getPracticeMoments(
+        const SpeedCategory &speedCategory, const Name &templateName, int splitIndex) {
+
+    static const std::vector<Moment> empty;
+
+    update(speedCategory);
+    auto it = practiceSet.find(std::make_pair(templateName, splitIndex));
+    return it == practiceSet.end() ? empty : it->second;
+}
+
+void TemplateIndex::markPut(
+        const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (performanceRevision != revisionBefore) return;
+    insertMoment(&performanceSet[value.getSplitTemplate()->getKey()], value.getKey());
+    performanceRevision = revisionAfter;
+}
+
+void TemplateIndex::markDelete(
+        const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (performanceRevision != revisionBefore) return;
+    auto it = performanceSet.find(value.getSplitTemplate()->getKey());
+    if (it != performanceSet.end()) {
+        eraseMoment(&it->second, value.getKey());
+        if (it->second.empty()) performanceSet.erase(it);
+    }
+    performanceRevision = revisionAfter;
+}
+
+void TemplateIndex::markPut(
+        const SplitPractice &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (practiceRevision != revisionBefore) return;
+    std::pair<Name, int> key = std::make_pair(value.getSplitTemplate()->getKey(), value.getSplitIndex());
+    insertMoment(&practiceSet[key], value.getKey());
+    practiceRevision = revisionAfter;
+}
+
+void TemplateIndex::markDelete(
+        const SplitPractice &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter) {
+
+    if (practiceRevision != revisionBefore) return;
+    auto it = practiceSet.find(std::make_pair(value.getSplitTemplate()->getKey(), value.getSplitIndex()));
+    if (it != practiceSet.end()) {
+        eraseMoment(&it->second, value.getKey());
+        if (it->second.empty()) practiceSet.erase(it);
+    }
+    practiceRevision = revisionAfter;
+}
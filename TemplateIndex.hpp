@@ -0,0 +1,63 @@
+#pragma once
+#include <map>
+#include <vector>
+#include "SplitMap.hpp"
+
+class SpeedCategory;
+
+class SplitPerformance;
+
+class SplitPractice;
+
+// moments of performances by template and of practices by template split, emptied rather than copied with category
+class TemplateIndex {
+
+private:
+
+    // sorted moments of each template with performances
+    std::map<Name, std::vector<Moment>> performanceSet;
+
+    // sorted moments of each template split with practices
+    std::map<std::pair<Name, int>, std::vector<Moment>> practiceSet;
+
+    // revision of map each index matches, 0 if never built
+    std::uint64_t performanceRevision;
+    std::uint64_t practiceRevision;
+
+    // keep moments sorted, appending without search when moment follows last moment
+
+    static void insertMoment(std::vector<Moment> *momentSet, const Moment &moment);
+
+    static void eraseMoment(std::vector<Moment> *momentSet, const Moment &moment);
+
+    // rebuild each index whose map changed without passing through this index
+
+    void update(const SpeedCategory &speedCategory);
+
+public:
+
+    // constructor
+
+    explicit TemplateIndex() : performanceRevision(0), practiceRevision(0) {}
+
+    TemplateIndex(const TemplateIndex &) : performanceRevision(0), practiceRevision(0) {}
+
+    TemplateIndex &operator=(const TemplateIndex &);
+
+    // moments of template in order, empty if none
+
+    const std::vector<Moment> &getPerformanceMoments(const SpeedCategory &speedCategory, const Name &templateName);
+
+    const std::vector<Moment> &getPracticeMoments(
+            const SpeedCategory &speedCategory, const Name &templateName, int splitIndex);
+
+    // mirror change of map from revision before to revision after, left to rebuild if index was already behind
+
+    void markPut(const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+
+    void markDelete(const SplitPerformance &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+
+    void markPut(const SplitPractice &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+
+    void markDelete(const SplitPractice &value, std::uint64_t revisionBefore, std::uint64_t revisionAfter);
+};
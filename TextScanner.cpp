@@ -0,0 +1,148 @@
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include "TextScanner.hpp"
+
+// exact powers of ten representable as double
+static const double powerOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static const int maxExactPower = 22;
+static const int maxMantissaDigitCount = 19;
+static const int maxPower = 100000;
+static const std::uint64_t maxExactMantissa = (std::uint64_t) 1 << 53;
+
+static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+TextScanner::TextScanner(const char *begin, const char *end) : position(begin), end(end), failed(false) {}
+
+bool TextScanner::skipSpace() {
+
+    while (position != end && isSpace(*position)) position++;
+    if (position == end) failed = true;
+    return !failed;
+}
+
+const char *TextScanner::tokenEnd() const {
+
+    const char *result = position;
+    while (result != end && !isSpace(*result)) result++;
+    return result;
+}
+
+bool TextScanner::parseInteger(long long &value, long long min, long long max) {
+
+    value = 0;
+    if (failed || !skipSpace()) return false;
+
+    const char *p = position;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    const char *digitStart = p;
+    unsigned long long magnitude = 0;
+    unsigned long long limit = negative ? (unsigned long long) -(min + 1) + 1 : (unsigned long long) max;
+    for (; p != end && isDigit(*p); p++) {
+        magnitude = magnitude * 10 + (unsigned long long) (*p - '0');
+        if (magnitude > limit) return !(failed = true);
+    }
+
+    if (p == digitStart || (p != end && !isSpace(*p))) return !(failed = true);
+
+    value = negative ? (long long) (0 - magnitude) : (long long) magnitude;
+    position = p;
+    return true;
+}
+
+TextScanner &TextScanner::operator>>(int &value) {
+
+    long long result;
+    parseInteger(result, INT_MIN, INT_MAX);
+    value = (int) result;
+    return *this;
+}
+
+TextScanner &TextScanner::operator>>(long long &value) {
+
+    parseInteger(value, LLONG_MIN, LLONG_MAX);
+    return *this;
+}
+
+TextScanner &TextScanner::operator>>(double &value) {
+
+    value = 0;
+    if (failed || !skipSpace()) return *this;
+
+    const char *p = position;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    std::uint64_t mantissa = 0;
+    int digitCount = 0;
+    int exponent = 0;
+    bool hasDigit = false;
+
+    for (; p != end && isDigit(*p); p++, hasDigit = true) {
+        if (mantissa == 0 && *p == '0') continue;
+        if (digitCount < maxMantissaDigitCount) mantissa = mantissa * 10 + (std::uint64_t) (*p - '0');
+        else exponent++;
+        digitCount++;
+    }
+    if (p != end && *p == '.') {
+        for (p++; p != end && isDigit(*p); p++, hasDigit = true) {
+            if (mantissa == 0 && *p == '0') {
+                exponent--;
+                continue;
+            }
+            if (digitCount < maxMantissaDigitCount) {
+                mantissa = mantissa * 10 + (std::uint64_t) (*p - '0');
+                exponent--;
+            }
+            digitCount++;
+        }
+    }
+    if (hasDigit && p != end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativePower = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+')) p++;
+        const char *powerStart = p;
+        int power = 0;
+        for (; p != end && isDigit(*p); p++) if (power < maxPower) power = power * 10 + (*p - '0');
+        if (p == powerStart) hasDigit = false;
+        exponent += negativePower ? -power : power;
+    }
+
+    bool isExact = hasDigit && (p == end || isSpace(*p)) &&
+                   digitCount <= maxMantissaDigitCount && mantissa <= maxExactMantissa &&
+                   exponent >= -maxExactPower && exponent <= maxExactPower;
+
+    if (isExact) {
+        double result = (double) mantissa;
+        result = exponent < 0 ? result / powerOfTen[-exponent] : result * powerOfTen[exponent];
+        value = negative ? -result : result;
+        position = p;
+        return *this;
+    }
+
+    const char *stop = tokenEnd();
+    std::string token(position, stop);
+    char *parsedEnd;
+    value = std::strtod(token.c_str(), &parsedEnd);
+    if (parsedEnd != token.c_str() + token.size()) failed = true;
+    else position = stop;
+    return *this;
+}
+
+TextScanner &TextScanner::operator>>(std::string &value) {
+
+    value.clear();
+    if (failed || !skipSpace()) return *this;
+
+    const char *stop = tokenEnd();
+    value.assign(position, stop);
+    position = stop;
+    return *this;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+
+// whitespace separated token scanner over byte range for file io
+class TextScanner {
+
+private:
+
+    // remaining byte range
+    const char *position;
+    const char *end;
+
+    // whether a token failed to parse
+    bool failed;
+
+    // skip whitespace and return whether token remains
+    bool skipSpace();
+
+    // end of token at position
+    const char *tokenEnd() const;
+
+    // parse signed integer token within range
+    bool parseInteger(long long &value, long long min, long long max);
+
+public:
+
+    // constructor
+
+    explicit TextScanner(const char *begin, const char *end);
+
+    // getter
+
+    bool fail() const { return failed; }
+
+    explicit operator bool() const { return !failed; }
+
+    // stream operator
+
+    TextScanner &operator>>(int &value);
+
+    TextScanner &operator>>(long long &value);
+
+    TextScanner &operator>>(double &value);
+
+    TextScanner &operator>>(std::string &value);
+};
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "TextWriter.hpp"
+
+// powers of ten for six significant digits of default stream precision
+static const double powerOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+static const unsigned long long integerPowerOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+static const int significantDigitCount = 6;
+
+// distance from rounding tie below which fast path defers to printf
+static const double tieMargin = 1e-6;
+
+const std::size_t TextWriter::initialSize = 1 << 16;
+const std::size_t TextWriter::flushSize = 1 << 24;
+
+TextWriter::TextWriter(std::ostream *stream) : stream(stream) { buffer.reserve(initialSize); }
+
+TextWriter::~TextWriter() { flush(); }
+
+void TextWriter::append(const char *data, std::size_t size) {
+
+    buffer.append(data, size);
+    if (buffer.size() >= flushSize) flush();
+}
+
+void TextWriter::appendInteger(unsigned long long magnitude, bool negative) {
+
+    char text[24];
+    char *start = text + sizeof(text);
+    do {
+        *--start = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) *--start = '-';
+    append(start, (std::size_t) (text + sizeof(text) - start));
+}
+
+void TextWriter::flush() {
+
+    if (buffer.empty()) return;
+    stream->write(buffer.data(), (std::streamsize) buffer.size());
+    buffer.clear();
+}
+
+TextWriter &TextWriter::operator<<(char value) {
+
+    append(&value, 1);
+    return *this;
+}
+
+TextWriter &TextWriter::operator<<(const char *value) {
+
+    append(value, std::strlen(value));
+    return *this;
+}
+
+TextWriter &TextWriter::operator<<(const std::string &value) {
+
+    append(value.data(), value.size());
+    return *this;
+}
+
+TextWriter &TextWriter::operator<<(int value) { return *this << (long long) value; }
+
+TextWriter &TextWriter::operator<<(long value) { return *this << (long long) value; }
+
+TextWriter &TextWriter::operator<<(long long value) {
+
+    bool negative = value < 0;
+    appendInteger(negative ? 0 - (unsigned long long) value : (unsigned long long) value, negative);
+    return *this;
+}
+
+TextWriter &TextWriter::operator<<(unsigned value) { return *this << (unsigned long long) value; }
+
+TextWriter &TextWriter::operator<<(unsigned long value) { return *this << (unsigned long long) value; }
+
+TextWriter &TextWriter::operator<<(unsigned long long value) {
+
+    appendInteger(value, false);
+    return *this;
+}
+
+TextWriter &TextWriter::operator<<(double value) {
+
+    // fixed notation of default stream precision for magnitude in [1, 1e6) away from rounding ties
+    double magnitude = std::fabs(value);
+    if (magnitude >= 1 && magnitude < powerOfTen[significantDigitCount]) {
+        int wholeDigitCount = 1;
+        while (wholeDigitCount < significantDigitCount && magnitude >= powerOfTen[wholeDigitCount]) wholeDigitCount++;
+
+        int fractionDigitCount = significantDigitCount - wholeDigitCount;
+        double scaled = magnitude * powerOfTen[fractionDigitCount];
+        double rounded = std::floor(scaled + 0.5);
+        bool nearTie = std::fabs(scaled - std::floor(scaled) - 0.5) < tieMargin;
+
+        if (!nearTie && rounded < powerOfTen[significantDigitCount]) {
+            auto digits = (unsigned long long) rounded;
+            unsigned long long fraction = digits % integerPowerOfTen[fractionDigitCount];
+            appendInteger(digits / integerPowerOfTen[fractionDigitCount], value < 0);
+
+            if (fraction != 0) {
+                char text[8];
+                text[0] = '.';
+                for (int i = fractionDigitCount; i > 0; i--, fraction /= 10) text[i] = (char) ('0' + fraction % 10);
+                int size = fractionDigitCount + 1;
+                while (text[size - 1] == '0') size--;
+                append(text, (std::size_t) size);
+            }
+
+            return *this;
+        }
+    }
+
+    char text[32];
+    int size = std::snprintf(text, sizeof(text), "%g", value);
+    append(text, (std::size_t) size);
+    return *this;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <iostream>
+#include <string>
+
+// text writer that formats into contiguous buffer and writes it to stream in one call for file io
+class TextWriter {
+
+private:
+
+    // destination of buffered text
+    std::ostream *stream;
+
+    // text not yet written to stream
+    std::string buffer;
+
+    // buffer size that forces write to stream
+    static const std::size_t initialSize;
+    static const std::size_t flushSize;
+
+    // append byte range and write buffer once it grows past limit
+    void append(const char *data, std::size_t size);
+
+    // append decimal digits of magnitude with optional sign
+    void appendInteger(unsigned long long magnitude, bool negative);
+
+public:
+
+    // constructor
+
+    explicit TextWriter(std::ostream *stream);
+
+    TextWriter(const TextWriter &) = delete;
+
+    TextWriter &operator=(const TextWriter &) = delete;
+
+    // destructor
+
+    ~TextWriter();
+
+    // write buffer to stream
+
+    void flush();
+
+    // stream operator
+
+    TextWriter &operator<<(char value);
+
+    TextWriter &operator<<(const char *value);
+
+    TextWriter &operator<<(const std::string &value);
+
+    TextWriter &operator<<(int value);
+
+    TextWriter &operator<<(long value);
+
+    TextWriter &operator<<(long long value);
+
+    TextWriter &operator<<(unsigned value);
+
+    TextWriter &operator<<(unsigned long value);
+
+    TextWriter &operator<<(unsigned long long value);
+
+    TextWriter &operator<<(double value);
+};
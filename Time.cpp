@@ -1,16 +1,151 @@
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include "Time.hpp"
 
-static std::string parse(const std::string &asString, char delimiter, int index) {
+// most digits read into one component, so it cannot overflow
+static const int parseDigitCount = 18;
 
-    std::string result;
-    std::stringstream asStream(asString);
+// read run of decimal digits at cursor and advance past it, false if none or too many
+static bool parseDigits(const char **cursor, const char *end, long long *result) {
 
-    for (int i = 0; i < index; i++) std::getline(asStream, result, delimiter);
-    std::getline(asStream, result, delimiter);
+    const char *begin = *cursor;
+    long long value = 0;
+    while (*cursor != end && **cursor >= '0' && **cursor <= '9') value = value * 10 + (*(*cursor)++ - '0');
+    *result = value;
+    return *cursor != begin && *cursor - begin <= parseDigitCount;
+}
+
+// read optional minus sign, false if there was one
+static bool parseSign(const char **cursor, const char *end) {
+
+    if (*cursor == end || **cursor != '-') return true;
+    (*cursor)++;
+    return false;
+}
+
+// read expected char at cursor and advance past it
+static bool parseChar(const char **cursor, const char *end, char expected) {
+
+    if (*cursor == end || **cursor != expected) return false;
+    (*cursor)++;
+    return true;
+}
+
+// read signed seconds up to limit with fraction as microseconds, rounding half to even past last microsecond
+static bool parseMicrosecondCount(const char **cursor, const char *end, long long wholeLimit, long long *result) {
+
+    bool positive = parseSign(cursor, end);
+    long long whole = 0;
+    if (!parseDigits(cursor, end, &whole) || whole > wholeLimit) return false;
+
+    long long fraction = 0;
+    if (parseChar(cursor, end, '.')) {
+        const char *begin = *cursor;
+        long long scale = Period::microsecondPerSecond;
+        int roundDigit = 0;
+        bool pastHalf = false;
+        for (; *cursor != end && **cursor >= '0' && **cursor <= '9'; (*cursor)++) {
+            scale /= 10;
+            if (scale > 0) fraction += (**cursor - '0') * scale;
+            else if (*cursor - begin == 6) roundDigit = **cursor - '0';
+            else if (**cursor != '0') pastHalf = true;
+        }
+        if (*cursor == begin) return false;
+        if (roundDigit > 5 || (roundDigit == 5 && (pastHalf || fraction % 2 == 1))) fraction++;
+    }
+
+    // limit on whole seconds alone still lets fraction carry past largest count
+    if (whole > (LLONG_MAX - fraction) / Period::microsecondPerSecond) return false;
+
+    long long magnitude = whole * Period::microsecondPerSecond + fraction;
+    *result = positive ? magnitude : -magnitude;
+    return true;
+}
+
+// longest exact decimal of microsecond count with terminator
+static const int formatCharCount = 32;
+
+// write microsecond count as seconds with only significant fraction digits, so text io is exact
+static void formatMicrosecondCount(long long microsecondCount, char *result) {
+
+    unsigned long long magnitude = microsecondCount < 0 ? 0 - (unsigned long long) microsecondCount :
+                                   (unsigned long long) microsecondCount;
+    unsigned long long whole = magnitude / (unsigned long long) Period::microsecondPerSecond;
+    unsigned long long fraction = magnitude % (unsigned long long) Period::microsecondPerSecond;
 
+    // whole digits in reverse
+    char digit[formatCharCount];
+    int digitCount = 0;
+    do {
+        digit[digitCount++] = (char) ('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+
+    if (microsecondCount < 0) *result++ = '-';
+    while (digitCount > 0) *result++ = digit[--digitCount];
+
+    if (fraction > 0) {
+        *result++ = '.';
+        for (unsigned long long scale = Period::microsecondPerSecond / 10; fraction > 0; scale /= 10) {
+            *result++ = (char) ('0' + fraction / scale);
+            fraction %= scale;
+        }
+    }
+    *result = '\0';
+}
+
+// write magnitude in decimal, zero padded after sign to width like printf %0*d, and return end
+static char *formatPadded(unsigned long long magnitude, bool negative, int width, char *result) {
+
+    char digit[formatCharCount];
+    int digitCount = 0;
+    do {
+        digit[digitCount++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (negative) *result++ = '-';
+    for (int i = digitCount + negative; i < width; i++) *result++ = '0';
+    while (digitCount > 0) *result++ = digit[--digitCount];
+    return result;
+}
+
+static char *formatPadded(long long value, int width, char *result) {
+
+    unsigned long long magnitude = value < 0 ? 0 - (unsigned long long) value : (unsigned long long) value;
+    return formatPadded(magnitude, value < 0, width, result);
+}
+
+template<class T, class C, class In>
+static T *importCount(In &stream, T *result, bool newObject) {
+
+    C count = 0;
+    stream >> count;
+    if (newObject) *result = T(count);
+    else result->set(count);
     return result;
 }
 
+// read exact decimal seconds as microseconds, leaving a failed read for caller to report
+template<class T, class In>
+static T *importMicrosecondCount(In &stream, T *result, const char *malformedMessage) {
+
+    std::string asString;
+    if (!(stream >> asString)) return result;
+
+    const char *cursor = asString.data(), *end = asString.data() + asString.size();
+    long long microsecondCount = 0;
+    if (!parseMicrosecondCount(&cursor, end, LLONG_MAX / Period::microsecondPerSecond, &microsecondCount) ||
+        cursor != end)
+        throw std::invalid_argument(malformedMessage);
+    *result = T::fromMicrosecondCount(microsecondCount);
+    return result;
+}
+
+const long long Period::microsecondPerSecond = 1000000;
 const int Period::secondPerMinute = 60;
 const int Period::minutePerHour = 60;
 const int Period::secondPerHour = secondPerMinute * minutePerHour;
@@ -27,18 +162,18 @@ const int Period::totalCharCount =
 
 const char Period::componentDelimiter = ':';
 
-Period::Period() : secondCount(set(0).secondCount) {}
+Period::Period() : microsecondCount(0) {}
 
-Period::Period(double secondCount) : secondCount(set(secondCount).secondCount) {}
+Period::Period(double secondCount) : microsecondCount(set(secondCount).microsecondCount) {}
 
 Period::Period(double secondCount, int minuteCount, int hourCount) :
-        secondCount(set(secondCount, minuteCount, hourCount).secondCount) {}
+        microsecondCount(set(secondCount, minuteCount, hourCount).microsecondCount) {}
 
-Period::Period(const std::string &asString) : secondCount(set(asString).secondCount) {}
+Period::Period(const std::string &asString) : microsecondCount(set(asString).microsecondCount) {}
 
 Period &Period::set(double newSecondCount) {
 
-    secondCount = newSecondCount;
+    microsecondCount = std::llrint(newSecondCount * (double) microsecondPerSecond);
     return *this;
 }
 
@@ -49,16 +184,24 @@ Period &Period::set(double newSecondCount, int minuteCount, int hourCount) {
 
 Period &Period::set(const std::string &asString) {
 
-    return set(parseSecondCount(asString), parseMinuteCount(asString), parseHourCount(asString));
+    if (!parse(asString.data(), asString.size(), this)) throw std::invalid_argument("malformed period");
+    return *this;
+}
+
+Period Period::fromMicrosecondCount(long long microsecondCount) {
+
+    Period result;
+    result.microsecondCount = microsecondCount;
+    return result;
 }
 
-double Period::secondInAllCount() const { return secondCount; }
+double Period::secondInAllCount() const { return (double) microsecondCount / (double) microsecondPerSecond; }
 
 double Period::secondInHourCount() const { return secondInAllCount() - secondPerHour * hourInAllCount(); }
 
 double Period::secondInMinuteCount() const { return secondInAllCount() - secondPerMinute * minuteInAllCount(); }
 
-int Period::minuteInAllCount() const { return (int) secondInAllCount() / secondPerMinute; }
+int Period::minuteInAllCount() const { return (int) (microsecondCount / microsecondPerSecond / secondPerMinute); }
 
 int Period::minuteInHourCount() const { return minuteInAllCount() - minutePerHour * hourInAllCount(); }
 
@@ -69,121 +212,194 @@ double Period::composeSecondCount(double secondCount, int minuteCount, int hourC
     return secondCount + secondPerMinute * minuteCount + secondPerHour * hourCount;
 }
 
-double Period::parseSecondCount(const std::string &asString) {
-
-    return std::stod(parse(asString, componentDelimiter, 2));
-}
-
-int Period::parseMinuteCount(const std::string &asString) {
-
-    return std::stoi(parse(asString, componentDelimiter, 1));
-}
-
-int Period::parseHourCount(const std::string &asString) {
-
-    return std::stoi(parse(asString, componentDelimiter, 0));
+bool Period::parse(const char *data, std::size_t size, Period *result) {
+
+    // each component carries own sign, as formatting does for negative periods
+    const char *cursor = data;
+    const char *end = data + size;
+    long long hourCount = 0;
+    long long minuteCount = 0;
+    long long secondMicrosecondCount = 0;
+
+    bool hourPositive = parseSign(&cursor, end);
+    if (!parseDigits(&cursor, end, &hourCount) || hourCount > INT32_MAX / secondPerHour) return false;
+    if (!parseChar(&cursor, end, componentDelimiter)) return false;
+    bool minutePositive = parseSign(&cursor, end);
+    if (!parseDigits(&cursor, end, &minuteCount) || minuteCount > INT32_MAX / secondPerMinute) return false;
+    if (!parseChar(&cursor, end, componentDelimiter)) return false;
+    if (!parseMicrosecondCount(&cursor, end, INT32_MAX, &secondMicrosecondCount) || cursor != end) return false;
+
+    long long secondCount =
+            (hourPositive ? hourCount : -hourCount) * secondPerHour +
+            (minutePositive ? minuteCount : -minuteCount) * secondPerMinute;
+    result->microsecondCount = secondCount * microsecondPerSecond + secondMicrosecondCount;
+    return true;
+}
+
+const int Period::bufferCharCount;
+
+int Period::format(char *result) const {
+
+    // exact seconds in minute rounded half away from zero at last decimal digit, carrying into 60 like printf
+    long long microsecondInMinute =
+            microsecondCount - (long long) minuteInAllCount() * secondPerMinute * microsecondPerSecond;
+    unsigned long long magnitude = microsecondInMinute < 0 ? 0 - (unsigned long long) microsecondInMinute :
+                                   (unsigned long long) microsecondInMinute;
+    unsigned long long decimalScale = 1;
+    for (int i = 0; i < secondDecimalDigitCount; i++) decimalScale *= 10;
+    unsigned long long unitScale = (unsigned long long) microsecondPerSecond / decimalScale;
+    unsigned long long unitCount = magnitude / unitScale;
+    unsigned long long remainder = magnitude % unitScale;
+    if (remainder * 2 >= unitScale) unitCount++;
+
+    char *end = result;
+    end = formatPadded(hourInAllCount(), hourDigitCount, end);
+    *end++ = componentDelimiter;
+    end = formatPadded(minuteInHourCount(), minuteDigitCount, end);
+    *end++ = componentDelimiter;
+    end = formatPadded(unitCount / decimalScale, microsecondInMinute < 0, secondWholeDigitCount, end);
+    *end++ = '.';
+    end = formatPadded(unitCount % decimalScale, false, secondDecimalDigitCount, end);
+    *end = '\0';
+    return (int) (end - result);
 }
 
 Period::operator std::string() const {
 
-    std::stringstream format;
-    format <<
-           "%0" << hourDigitCount << "d" << componentDelimiter <<
-           "%0" << minuteDigitCount << "d" << componentDelimiter <<
-           "%0" << secondWholeDigitCount + secondDecimalDigitCount + 1 << "." << secondDecimalDigitCount << "f";
-
-    char result[totalCharCount + 1];
-    sprintf(result, format.str().c_str(), hourInAllCount(), minuteInHourCount(), secondInMinuteCount());
-    return result;
+    char result[bufferCharCount];
+    return std::string(result, (std::size_t) format(result));
 }
 
-Period Period::operator+(const Period &a) const { return Period(secondCount + a.secondCount); }
-
-Period Period::operator-(const Period &a) const { return Period(secondCount - a.secondCount); }
+Period Period::operator+(const Period &a) const { return fromMicrosecondCount(microsecondCount + a.microsecondCount); }
 
-Period Period::operator*(double a) const { return Period(secondCount * a); }
+Period Period::operator-(const Period &a) const { return fromMicrosecondCount(microsecondCount - a.microsecondCount); }
 
-Period Period::operator/(double a) const { return Period(secondCount / a); }
+Period Period::operator*(double a) const { return fromMicrosecondCount(std::llrint((double) microsecondCount * a)); }
 
-double Period::operator/(const Period &a) const { return secondCount / a.secondCount; }
+Period Period::operator/(double a) const { return fromMicrosecondCount(std::llrint((double) microsecondCount / a)); }
 
-Period &Period::operator=(const Period &a) {
-
-    set(a.secondCount);
-    return *this;
-}
+double Period::operator/(const Period &a) const { return (double) microsecondCount / (double) a.microsecondCount; }
 
 Period &Period::operator+=(const Period &a) {
 
-    set(secondCount + a.secondCount);
+    microsecondCount += a.microsecondCount;
     return *this;
 }
 
 Period &Period::operator-=(const Period &a) {
 
-    set(secondCount - a.secondCount);
+    microsecondCount -= a.microsecondCount;
     return *this;
 }
 
 Period &Period::operator*=(double a) {
 
-    set(secondCount * a);
+    microsecondCount = std::llrint((double) microsecondCount * a);
     return *this;
 }
 
 Period &Period::operator/=(double a) {
 
-    set(secondCount / a);
+    microsecondCount = std::llrint((double) microsecondCount / a);
     return *this;
 }
 
-bool Period::operator==(const Period &a) const { return secondCount == a.secondCount; }
+bool Period::operator==(const Period &a) const { return microsecondCount == a.microsecondCount; }
 
-bool Period::operator!=(const Period &a) const { return secondCount != a.secondCount; }
+bool Period::operator!=(const Period &a) const { return microsecondCount != a.microsecondCount; }
 
-bool Period::operator<(const Period &a) const { return secondCount < a.secondCount; }
+bool Period::operator<(const Period &a) const { return microsecondCount < a.microsecondCount; }
 
-bool Period::operator>(const Period &a) const { return secondCount > a.secondCount; }
+bool Period::operator>(const Period &a) const { return microsecondCount > a.microsecondCount; }
 
-bool Period::operator<=(const Period &a) const { return secondCount <= a.secondCount; }
+bool Period::operator<=(const Period &a) const { return microsecondCount <= a.microsecondCount; }
 
-bool Period::operator>=(const Period &a) const { return secondCount >= a.secondCount; }
+bool Period::operator>=(const Period &a) const { return microsecondCount >= a.microsecondCount; }
 
 std::ostream &operator<<(std::ostream &stream, const Period &period) {
 
-    return stream << period.operator std::string();
+    char result[Period::bufferCharCount];
+    period.format(result);
+    return stream << result;
+}
+
+TextWriter &operator<<(TextWriter &stream, const Period &period) {
+
+    char result[Period::bufferCharCount];
+    period.format(result);
+    return stream << result;
 }
 
 std::istream &operator>>(std::istream &stream, Period &period) {
 
     std::string asString;
     stream >> asString;
-    period.set(asString);
+    if (!Period::parse(asString.data(), asString.size(), &period)) stream.setstate(std::ios::failbit);
     return stream;
 }
 
 const std::ostream &Period::exportFull(std::ostream &stream, bool newObject) const {
 
-    return stream << secondCount << " ";
+    char result[formatCharCount];
+    formatMicrosecondCount(microsecondCount, result);
+    return stream << result << " ";
+}
+
+const TextWriter &Period::exportFull(TextWriter &stream, bool newObject) const {
+
+    char result[formatCharCount];
+    formatMicrosecondCount(microsecondCount, result);
+    return stream << result << " ";
 }
 
 Period *Period::importFull(std::istream &stream, Period *result, bool newObject) {
 
-    double secondCount;
-    stream >> secondCount;
-    if (newObject) *result = Period(secondCount);
-    else result->set(secondCount);
+    return importMicrosecondCount(stream, result, "malformed period");
+}
+
+Period *Period::importFull(TextScanner &stream, Period *result, bool newObject) {
+
+    return importMicrosecondCount(stream, result, "malformed period");
+}
+
+BinaryWriter &Period::exportBinary(BinaryWriter &writer, bool newObject) const {
+
+    writer.writeI64(microsecondCount);
+    return writer;
+}
+
+Period *Period::importBinary(BinaryReader &reader, Period *result, bool newObject) {
+
+    // files before microsecond version hold periods as double seconds
+    if (reader.getVersion() < BinaryWriter::microsecondVersion) *result = Period(reader.readF64());
+    else *result = fromMicrosecondCount(reader.readI64());
     return result;
 }
 
 const int Date::dayPerYear = 365;
 const int Date::leapYearDifferenceByYear = 1;
 const int Date::monthPerYear = 12;
-const int Date::yearPerLeapCycle = 4;
+const int Date::yearPerLeapYear = 4;
+const int Date::yearPerSkippedLeapYear = 100;
+const int Date::yearPerLeapCycle = 400;
 const int Date::monthPerLeapCycle = monthPerYear * yearPerLeapCycle;
-const int Date::dayPerLeapCycle = dayPerYear * yearPerLeapCycle + leapYearDifferenceByYear;
+const int Date::dayPerLeapCycle =
+        dayPerYear * yearPerLeapCycle +
+        leapYearDifferenceByYear * (yearPerLeapCycle / yearPerLeapYear - yearPerLeapCycle / yearPerSkippedLeapYear + 1);
 const int Date::dayPerMonthByMonth[monthPerYear] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 const int Date::leapYearDifferenceByMonth[monthPerYear] = {00, 01, 00, 00, 00, 00, 00, 00, 00, 00, 00, 00};
+const int Date::dayCountOffset = 15;
+
+// days before each month in common year, and before each month of year starting 1 Mar so leap day falls last
+static constexpr int dayBeforeMonthByMonth[] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+static constexpr int dayBeforeMonthFromMarch[] = {0, 31, 61, 92, 122, 153, 184, 214, 245, 275, 306, 337};
+
+// months and days of year 0 before 1 Mar
+static constexpr int monthBeforeMarch = 2;
+static constexpr int dayBeforeMarch = 31 + 29;
+
+// quotient rounded toward negative infinity
+static int floorDivide(int a, int b) { return a / b - (a % b != 0 && (a < 0) != (b < 0)); }
 
 const int Date::dayDigitCount = 2;
 const int Date::monthDigitCount = 2;
@@ -218,105 +434,146 @@ Date &Date::set(int newDayCount, int monthCount, int yearCount) {
 
 Date &Date::set(const std::string &asString) {
 
-    return set(parseDayCount(asString), parseMonthCount(asString), parseYearCount(asString));
+    if (!parse(asString.data(), asString.size(), this)) throw std::invalid_argument("malformed date");
+    return *this;
 }
 
 int Date::dayInAllCount() const { return dayCount; }
 
-int Date::dayInLeapCycleCount() const { return dayInAllCount() - dayPerLeapCycle * leapCycleInAllCount(); }
+int Date::dayInLeapCycleCount() const { return dayCount - dayCountOffset - dayPerLeapCycle * leapCycleInAllCount(); }
 
-int Date::monthInAllCount() const { return monthInLeapCycleCount() + monthPerLeapCycle * leapCycleInAllCount(); }
+int Date::monthInAllCount() const { return monthInYearCount() + monthPerYear * yearInAllCount(); }
 
 int Date::monthInLeapCycleCount() const { return monthInYearCount() + monthPerYear * yearInLeapCycleCount(); }
 
-int Date::yearInAllCount() const { return yearInLeapCycleCount() + yearPerLeapCycle * leapCycleInAllCount(); }
+int Date::yearInAllCount() const {
 
-int Date::leapCycleInAllCount() const { return dayInAllCount() / dayPerLeapCycle; }
+    int dayInMonth, monthInYear, year;
+    decompose(&dayInMonth, &monthInYear, &year);
+    return year;
+}
 
-bool Date::isLeapYear() const { return yearInLeapCycleCount() == 0; }
+int Date::yearInLeapCycleCount() const { return yearInAllCount() - yearPerLeapCycle * leapCycleInAllCount(); }
+
+int Date::leapCycleInAllCount() const { return floorDivide(dayCount - dayCountOffset, dayPerLeapCycle); }
+
+bool Date::isLeapYear() const { return isLeapYear(yearInAllCount()); }
+
+bool Date::isLeapYear(int yearCount) {
+
+    return yearCount % yearPerLeapYear == 0 &&
+           (yearCount % yearPerSkippedLeapYear != 0 || yearCount % yearPerLeapCycle == 0);
+}
 
 int Date::dayInYearCount() const {
 
-    return dayInLeapCycleCount() - dayPerYear * yearInLeapCycleCount() - !isLeapYear() * leapYearDifferenceByYear;
+    int dayInMonth, monthInYear, year;
+    decompose(&dayInMonth, &monthInYear, &year);
+    return dayBeforeMonthByMonth[monthInYear] + dayInMonth +
+           (isLeapYear(year) && monthInYear >= monthBeforeMarch) * leapYearDifferenceByYear;
 }
 
 int Date::dayInMonthCount() const {
 
-    int dayInYear = dayInYearCount();
-    dayInYear -= std::accumulate(dayPerMonthByMonth, dayPerMonthByMonth + monthInYearCount(), 0);
-    if (isLeapYear())
-        dayInYear -= std::accumulate(leapYearDifferenceByMonth, leapYearDifferenceByMonth + monthInYearCount(), 0);
-    return dayInYear;
+    int dayInMonth, monthInYear, year;
+    decompose(&dayInMonth, &monthInYear, &year);
+    return dayInMonth;
 }
 
 int Date::monthInYearCount() const {
 
-    int dayInYear = dayInYearCount();
-    for (int i = 0; i < monthPerYear; i++) {
-        if (dayInYear < dayPerMonthByMonth[i] + isLeapYear() * leapYearDifferenceByMonth[i]) return i;
-        dayInYear -= dayPerMonthByMonth[i] + isLeapYear() * leapYearDifferenceByMonth[i];
-    }
-    return monthPerYear;
+    int dayInMonth, monthInYear, year;
+    decompose(&dayInMonth, &monthInYear, &year);
+    return monthInYear;
 }
 
-int Date::yearInLeapCycleCount() const {
+void Date::decompose(int *dayInMonth, int *monthInYear, int *year) const {
+
+    // count years from 1 Mar, so leap day ends year and year length in cycle follows from division alone
+    int dayFromMarch = dayCount - dayCountOffset - dayBeforeMarch;
+    int leapCycle = floorDivide(dayFromMarch, dayPerLeapCycle);
+    int dayInLeapCycle = dayFromMarch - dayPerLeapCycle * leapCycle;
+
+    const int dayPerLeapYear = dayPerYear * yearPerLeapYear + leapYearDifferenceByYear;
+    const int dayPerSkippedLeapYear = dayPerLeapYear * (yearPerSkippedLeapYear / yearPerLeapYear) - 1;
+    int yearInLeapCycle =
+            (dayInLeapCycle - dayInLeapCycle / (dayPerLeapYear - 1) +
+             dayInLeapCycle / dayPerSkippedLeapYear - dayInLeapCycle / (dayPerLeapCycle - 1)) / dayPerYear;
+    int dayInYear = dayInLeapCycle - dayPerYear * yearInLeapCycle -
+                    yearInLeapCycle / yearPerLeapYear + yearInLeapCycle / yearPerSkippedLeapYear;
 
-    int dayInLeapCycle = dayInLeapCycleCount();
-    if (dayInLeapCycle < dayPerYear + leapYearDifferenceByYear) return 0;
-    dayInLeapCycle -= dayPerYear + leapYearDifferenceByYear;
-    return dayInLeapCycle / dayPerYear + 1;
+    // months from March alternate 31 and 30 days in runs of five, so month follows from day in year
+    int monthFromMarch = (5 * dayInYear + 2) / 153;
+    *dayInMonth = dayInYear - dayBeforeMonthFromMarch[monthFromMarch];
+    *monthInYear = (monthFromMarch + monthBeforeMarch) % monthPerYear;
+    *year = yearInLeapCycle + yearPerLeapCycle * leapCycle + (*monthInYear < monthBeforeMarch);
 }
 
 int Date::composeDayCount(int dayCount, int monthCount, int yearCount) {
 
-    int leapCycleCount = yearCount / yearPerLeapCycle;
-    int yearInLeapCycle = yearCount - yearPerLeapCycle * leapCycleCount;
-    return composeDayCount(dayCount, monthCount, yearInLeapCycle, leapCycleCount);
+    yearCount += floorDivide(monthCount, monthPerYear);
+    monthCount -= monthPerYear * floorDivide(monthCount, monthPerYear);
+
+    int yearFromMarch = yearCount - (monthCount < monthBeforeMarch);
+    int leapCycle = floorDivide(yearFromMarch, yearPerLeapCycle);
+    int yearInLeapCycle = yearFromMarch - yearPerLeapCycle * leapCycle;
+    int monthFromMarch = (monthCount + monthPerYear - monthBeforeMarch) % monthPerYear;
+
+    int dayInLeapCycle =
+            dayPerYear * yearInLeapCycle +
+            yearInLeapCycle / yearPerLeapYear - yearInLeapCycle / yearPerSkippedLeapYear +
+            dayBeforeMonthFromMarch[monthFromMarch] + dayCount;
+    return dayPerLeapCycle * leapCycle + dayInLeapCycle + dayBeforeMarch + dayCountOffset;
 }
 
 int Date::composeDayCount(int dayCount, int monthCount, int yearCount, int leapCycleCount) {
 
-    int sum = 0;
-    bool isLeapYear = yearCount == 0;
-    bool pastLeapYear = yearCount > 0;
-
-    sum += dayCount;
-    sum += dayPerYear * yearCount;
-    sum += dayPerLeapCycle * leapCycleCount;
-    sum += pastLeapYear * leapYearDifferenceByYear;
+    return composeDayCount(dayCount, monthCount, yearCount + yearPerLeapCycle * leapCycleCount);
+}
 
-    sum += std::accumulate(dayPerMonthByMonth, dayPerMonthByMonth + monthCount, 0);
-    sum += isLeapYear * std::accumulate(leapYearDifferenceByMonth, leapYearDifferenceByMonth + monthCount, 0);
+bool Date::parse(const char *data, std::size_t size, Date *result) {
 
-    return sum;
-}
+    const char *cursor = data;
+    const char *end = data + size;
+    long long monthCount = 0;
+    long long dayCount = 0;
+    long long yearCount = 0;
 
-int Date::parseDayCount(const std::string &asString) {
+    if (!parseDigits(&cursor, end, &monthCount) || monthCount < 1 || monthCount > monthPerYear) return false;
+    if (!parseChar(&cursor, end, componentDelimiter)) return false;
+    if (!parseDigits(&cursor, end, &dayCount) || dayCount < 1 || dayCount > dayPerMonthByMonth[0]) return false;
+    if (!parseChar(&cursor, end, componentDelimiter)) return false;
+    if (!parseDigits(&cursor, end, &yearCount) || yearCount > INT32_MAX / (dayPerYear + 1) || cursor != end)
+        return false;
 
-    return std::stoi(parse(asString, componentDelimiter, 1)) - 1;
+    // reject day past end of month rather than rolling into next month
+    Date date((int) dayCount - 1, (int) monthCount - 1, (int) yearCount);
+    if (date.dayInMonthCount() != dayCount - 1) return false;
+    *result = date;
+    return true;
 }
 
-int Date::parseMonthCount(const std::string &asString) {
+const int Date::bufferCharCount;
 
-    return std::stoi(parse(asString, componentDelimiter, 0)) - 1;
-}
+int Date::format(char *result) const {
 
-int Date::parseYearCount(const std::string &asString) {
+    int dayInMonth, monthInYear, year;
+    decompose(&dayInMonth, &monthInYear, &year);
 
-    return std::stoi(parse(asString, componentDelimiter, 2));
+    char *end = result;
+    end = formatPadded(monthInYear + 1, monthDigitCount, end);
+    *end++ = componentDelimiter;
+    end = formatPadded(dayInMonth + 1, dayDigitCount, end);
+    *end++ = componentDelimiter;
+    end = formatPadded(year, yearDigitCount, end);
+    *end = '\0';
+    return (int) (end - result);
 }
 
 Date::operator std::string() const {
 
-    std::stringstream format;
-    format <<
-           "%0" << monthDigitCount << "d" << componentDelimiter <<
-           "%0" << dayDigitCount << "d" << componentDelimiter <<
-           "%0" << yearDigitCount << "d";
-
-    char result[totalCharCount + 1];
-    sprintf(result, format.str().c_str(), monthInYearCount() + 1, dayInMonthCount() + 1, yearInAllCount());
-    return result;
+    char result[bufferCharCount];
+    return std::string(result, (std::size_t) format(result));
 }
 
 Date &Date::operator=(const Date &a) {
@@ -339,14 +596,23 @@ bool Date::operator>=(const Date &a) const { return dayCount >= a.dayCount; }
 
 std::ostream &operator<<(std::ostream &stream, const Date &date) {
 
-    return stream << date.operator std::string();
+    char result[Date::bufferCharCount];
+    date.format(result);
+    return stream << result;
+}
+
+TextWriter &operator<<(TextWriter &stream, const Date &date) {
+
+    char result[Date::bufferCharCount];
+    date.format(result);
+    return stream << result;
 }
 
 std::istream &operator>>(std::istream &stream, Date &date) {
 
     std::string asString;
     stream >> asString;
-    date.set(asString);
+    if (!Date::parse(asString.data(), asString.size(), &date)) stream.setstate(std::ios::failbit);
     return stream;
 }
 
@@ -355,16 +621,37 @@ const std::ostream &Date::exportFull(std::ostream &stream, bool newObject) const
     return stream << dayCount << " ";
 }
 
+const TextWriter &Date::exportFull(TextWriter &stream, bool newObject) const {
+
+    return stream << dayCount << " ";
+}
+
 Date *Date::importFull(std::istream &stream, Date *result, bool newObject) {
 
-    int dayCount;
-    stream >> dayCount;
+    return importCount<Date, int>(stream, result, newObject);
+}
+
+Date *Date::importFull(TextScanner &stream, Date *result, bool newObject) {
+
+    return importCount<Date, int>(stream, result, newObject);
+}
+
+BinaryWriter &Date::exportBinary(BinaryWriter &writer, bool newObject) const {
+
+    writer.writeI32(dayCount);
+    return writer;
+}
+
+Date *Date::importBinary(BinaryReader &reader, Date *result, bool newObject) {
+
+    int dayCount = reader.readI32();
     if (newObject) *result = Date(dayCount);
     else result->set(dayCount);
     return result;
 }
 
 const int Moment::hourPerDay = 24;
+const long long Moment::microsecondPerDay = Period::microsecondPerSecond * Period::secondPerHour * hourPerDay;
 
 const int Moment::extraCharCount = 1;
 const int Moment::totalCharCount = Date::totalCharCount + Period::totalCharCount + extraCharCount;
@@ -373,114 +660,154 @@ const char Moment::componentDelimiter = '@';
 const Moment Moment::epoch = Moment(Date(0, 0, 1970), Period(0, 0, 0));
 const std::string Moment::nowToken = "NOW";
 
-Moment::Moment() : secondCount(set(0).secondCount) {}
+Moment::Moment() : microsecondCount(set(0).microsecondCount) {}
 
-Moment::Moment(long long secondCount) : secondCount(set(secondCount).secondCount) {}
+Moment::Moment(long long secondCount) : microsecondCount(set(secondCount).microsecondCount) {}
 
 Moment::Moment(const Date &day, const Period &time) :
-        secondCount(set(day, time).secondCount) {}
+        microsecondCount(set(day, time).microsecondCount) {}
 
-Moment::Moment(const std::string &asString) : secondCount(set(asString).secondCount) {}
+Moment::Moment(const std::string &asString) : microsecondCount(set(asString).microsecondCount) {}
 
 Moment &Moment::set(long long newSecondCount) {
 
-    secondCount = newSecondCount;
+    microsecondCount = newSecondCount * Period::microsecondPerSecond;
     return *this;
 }
 
 Moment &Moment::set(const Date &day, const Period &time) {
 
-    return set(composeSecondCount(day, time));
+    microsecondCount = composeMicrosecondCount(day, time);
+    return *this;
 }
 
 Moment &Moment::set(const std::string &asString) {
 
-    return set(parseDay(asString), parseTime(asString));
+    if (!parse(asString.data(), asString.size(), this)) throw std::invalid_argument("malformed moment");
+    return *this;
 }
 
-long long Moment::getSecondCount() const { return secondCount; }
+Moment Moment::fromMicrosecondCount(long long microsecondCount) {
 
-Date Moment::getDay() const {
-
-    return Date((int) (secondCount / Period::secondPerHour / hourPerDay));
+    Moment result;
+    result.microsecondCount = microsecondCount;
+    return result;
 }
 
+Date Moment::getDay() const { return Date((int) (microsecondCount / microsecondPerDay)); }
+
 Period Moment::getTime() const {
 
-    return Period((double) (secondCount - (long long) getDay().dayInAllCount() * hourPerDay * Period::secondPerHour));
+    return Period::fromMicrosecondCount(microsecondCount - getDay().dayInAllCount() * microsecondPerDay);
 }
 
-long long Moment::composeSecondCount(const Date &day, const Period &time) {
+long long Moment::composeMicrosecondCount(const Date &day, const Period &time) {
 
-    return (long long) time.secondInAllCount() + (long long) day.dayInAllCount() * hourPerDay * Period::secondPerHour;
+    return time.microsecondInAllCount() + day.dayInAllCount() * microsecondPerDay;
 }
 
-Date Moment::parseDay(const std::string &asString) {
-
-    return Date(parse(asString, componentDelimiter, 0));
-}
+bool Moment::parse(const char *data, std::size_t size, Moment *result) {
 
-Period Moment::parseTime(const std::string &asString) {
+    const char *delimiter = (const char *) std::memchr(data, componentDelimiter, size);
+    if (!delimiter) return false;
 
-    return Period(parse(asString, componentDelimiter, 1));
+    Date day;
+    Period time;
+    if (!Date::parse(data, (std::size_t) (delimiter - data), &day)) return false;
+    if (!Period::parse(delimiter + 1, (std::size_t) (data + size - delimiter - 1), &time)) return false;
+    result->set(day, time);
+    return true;
 }
 
-Moment Moment::parseWithNow(const std::string &asString) {
+const int Moment::bufferCharCount;
 
-    if (asString == nowToken) return now();
-    return Moment(asString);
-}
+int Moment::format(char *result) const {
 
-Moment Moment::now() { return Moment(std::time(nullptr) + Moment::epoch.getSecondCount()); }
+    int charCount = getDay().format(result);
+    result[charCount++] = componentDelimiter;
+    return charCount + getTime().format(result + charCount);
+}
 
 Moment::operator std::string() const {
 
-    std::stringstream result;
-    result << getDay() << Moment::componentDelimiter << getTime();
-    return result.str();
+    char result[bufferCharCount];
+    return std::string(result, (std::size_t) format(result));
 }
 
 Moment &Moment::operator=(const Moment &a) {
 
-    set(a.secondCount);
+    microsecondCount = a.microsecondCount;
     return *this;
 }
 
-bool Moment::operator==(const Moment &a) const { return secondCount == a.secondCount; }
+bool Moment::operator==(const Moment &a) const { return microsecondCount == a.microsecondCount; }
 
-bool Moment::operator!=(const Moment &a) const { return secondCount != a.secondCount; }
+bool Moment::operator!=(const Moment &a) const { return microsecondCount != a.microsecondCount; }
 
-bool Moment::operator<(const Moment &a) const { return secondCount < a.secondCount; }
+bool Moment::operator<(const Moment &a) const { return microsecondCount < a.microsecondCount; }
 
-bool Moment::operator>(const Moment &a) const { return secondCount > a.secondCount; }
+bool Moment::operator>(const Moment &a) const { return microsecondCount > a.microsecondCount; }
 
-bool Moment::operator<=(const Moment &a) const { return secondCount <= a.secondCount; }
+bool Moment::operator<=(const Moment &a) const { return microsecondCount <= a.microsecondCount; }
 
-bool Moment::operator>=(const Moment &a) const { return secondCount >= a.secondCount; }
+bool Moment::operator>=(const Moment &a) const { return microsecondCount >= a.microsecondCount; }
 
 std::ostream &operator<<(std::ostream &stream, const Moment &moment) {
 
-    return stream << moment.operator std::string();
+    char result[Moment::bufferCharCount];
+    moment.format(result);
+    return stream << result;
+}
+
+TextWriter &operator<<(TextWriter &stream, const Moment &moment) {
+
+    char result[Moment::bufferCharCount];
+    moment.format(result);
+    return stream << result;
 }
 
 std::istream &operator>>(std::istream &stream, Moment &moment) {
 
     std::string asString;
     stream >> asString;
-    moment.set(asString);
+    if (!Moment::parse(asString.data(), asString.size(), &moment)) stream.setstate(std::ios::failbit);
     return stream;
 }
 
 const std::ostream &Moment::exportFull(std::ostream &stream, bool newObject) const {
 
-    return stream << secondCount << " ";
+    char result[formatCharCount];
+    formatMicrosecondCount(microsecondCount, result);
+    return stream << result << " ";
+}
+
+const TextWriter &Moment::exportFull(TextWriter &stream, bool newObject) const {
+
+    char result[formatCharCount];
+    formatMicrosecondCount(microsecondCount, result);
+    return stream << result << " ";
 }
 
 Moment *Moment::importFull(std::istream &stream, Moment *result, bool newObject) {
 
-    long long secondCount;
-    stream >> secondCount;
-    if (newObject) *result = Moment(secondCount);
-    else result->set(secondCount);
+    return importMicrosecondCount(stream, result, "malformed moment");
+}
+
+Moment *Moment::importFull(TextScanner &stream, Moment *result, bool newObject) {
+
+    return importMicrosecondCount(stream, result, "malformed moment");
+}
+
+BinaryWriter &Moment::exportBinary(BinaryWriter &writer, bool newObject) const {
+
+    writer.writeI64(microsecondCount);
+    return writer;
+}
+
+Moment *Moment::importBinary(BinaryReader &reader, Moment *result, bool newObject) {
+
+    long long count = reader.readI64();
+    if (reader.getVersion() < BinaryWriter::microsecondVersion) count *= Period::microsecondPerSecond;
+    *result = fromMicrosecondCount(count);
     return result;
 }
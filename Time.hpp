@@ -9,12 +9,13 @@ class Period : public StreamIO<Period> {
 
 private:
 
-    // elapsed seconds
-    double secondCount;
+    // elapsed microseconds, exact under addition and subtraction
+    long long microsecondCount;
 
 public:
 
     // conversion factor
+    static const long long microsecondPerSecond;
     static const int secondPerMinute;
     static const int minutePerHour;
     static const int secondPerHour;
@@ -28,6 +29,9 @@ public:
     static const int totalCharCount;
     static const char componentDelimiter;
 
+    // size of buffer that fits any formatted period with terminator
+    static const int bufferCharCount = 32;
+
     // constructor
 
     explicit Period();
@@ -46,8 +50,12 @@ public:
 
     Period &set(const std::string &asString);
 
+    static Period fromMicrosecondCount(long long microsecondCount);
+
     // unit conversion
 
+    long long microsecondInAllCount() const { return microsecondCount; }
+
     double secondInAllCount() const;
 
     double secondInHourCount() const;
@@ -62,13 +70,13 @@ public:
 
     static double composeSecondCount(double secondCount, int minuteCount, int hourCount);
 
-    // parsing
+    // parse hours, minutes and seconds with optional fraction in single pass, false if malformed
 
-    static double parseSecondCount(const std::string &asString);
+    static bool parse(const char *data, std::size_t size, Period *result);
 
-    static int parseMinuteCount(const std::string &asString);
+    // write formatted period with terminator into buffer of buffer char count and return char count
 
-    static int parseHourCount(const std::string &asString);
+    int format(char *result) const;
 
     // to string operator
 
@@ -86,8 +94,6 @@ public:
 
     double operator/(const Period &a) const;
 
-    Period &operator=(const Period &a);
-
     Period &operator+=(const Period &a);
 
     Period &operator-=(const Period &a);
@@ -114,13 +120,25 @@ public:
 
     friend std::ostream &operator<<(std::ostream &stream, const Period &period);
 
+    friend TextWriter &operator<<(TextWriter &stream, const Period &period);
+
     friend std::istream &operator>>(std::istream &stream, Period &period);
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override;
+    const std::ostream &exportFull(std::ostream &stream, bool newObject) const;
+
+    const TextWriter &exportFull(TextWriter &stream, bool newObject) const;
 
     static Period *importFull(std::istream &stream, Period *result, bool newObject);
+
+    static Period *importFull(TextScanner &stream, Period *result, bool newObject);
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const;
+
+    static Period *importBinary(BinaryReader &reader, Period *result, bool newObject);
 };
 
 // standard calendar day
@@ -131,18 +149,26 @@ private:
     // elapsed days
     int dayCount;
 
+    // day, month and year of day count in closed form
+    void decompose(int *dayInMonth, int *monthInYear, int *year) const;
+
 public:
 
     // conversion factor
     static const int leapYearDifferenceByYear;
     static const int dayPerYear;
     static const int monthPerYear;
+    static const int yearPerLeapYear;
+    static const int yearPerSkippedLeapYear;
     static const int yearPerLeapCycle;
     static const int monthPerLeapCycle;
     static const int dayPerLeapCycle;
     static const int dayPerMonthByMonth[];
     static const int leapYearDifferenceByMonth[];
 
+    // day count of 1 Jan of year 0, so days after Feb 1900 keep count of former four-year leap cycle
+    static const int dayCountOffset;
+
     // formatting
     static const int dayDigitCount;
     static const int monthDigitCount;
@@ -151,6 +177,9 @@ public:
     static const int totalCharCount;
     static const char componentDelimiter;
 
+    // size of buffer that fits any formatted date with terminator
+    static const int bufferCharCount = 32;
+
     // constructor
 
     explicit Date();
@@ -193,17 +222,19 @@ public:
 
     bool isLeapYear() const;
 
+    static bool isLeapYear(int yearCount);
+
     static int composeDayCount(int dayCount, int monthCount, int yearCount);
 
     static int composeDayCount(int dayCount, int monthCount, int yearCount, int leapCycleCount);
 
-    // parsing
+    // parse month, day and year in single pass, false if malformed or not a calendar day
 
-    static int parseDayCount(const std::string &asString);
+    static bool parse(const char *data, std::size_t size, Date *result);
 
-    static int parseMonthCount(const std::string &asString);
+    // write formatted date with terminator into buffer of buffer char count and return char count
 
-    static int parseYearCount(const std::string &asString);
+    int format(char *result) const;
 
     // to string operator
 
@@ -229,13 +260,25 @@ public:
 
     friend std::ostream &operator<<(std::ostream &stream, const Date &period);
 
+    friend TextWriter &operator<<(TextWriter &stream, const Date &period);
+
     friend std::istream &operator>>(std::istream &stream, Date &period);
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override;
+    const std::ostream &exportFull(std::ostream &stream, bool newObject) const;
+
+    const TextWriter &exportFull(TextWriter &stream, bool newObject) const;
 
     static Date *importFull(std::istream &stream, Date *result, bool newObject);
+
+    static Date *importFull(TextScanner &stream, Date *result, bool newObject);
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const;
+
+    static Date *importBinary(BinaryReader &reader, Date *result, bool newObject);
 };
 
 
@@ -244,19 +287,23 @@ class Moment : public StreamIO<Moment> {
 
 private:
 
-    // elapsed seconds
-    long long secondCount;
+    // elapsed microseconds, so moments recorded within one second stay distinct
+    long long microsecondCount;
 
 public:
 
     // conversion factor
     static const int hourPerDay;
+    static const long long microsecondPerDay;
 
     // formatting
     static const int extraCharCount;
     static const int totalCharCount;
     static const char componentDelimiter;
 
+    // size of buffer that fits any formatted moment with terminator
+    static const int bufferCharCount = Date::bufferCharCount + Period::bufferCharCount;
+
     // standard epoch - 1 Jan 1970
     static const Moment epoch;
 
@@ -281,27 +328,27 @@ public:
 
     Moment &set(const std::string &asString);
 
+    static Moment fromMicrosecondCount(long long microsecondCount);
+
     // unit conversion
 
-    long long getSecondCount() const;
+    long long getMicrosecondCount() const { return microsecondCount; }
+
+    long long getSecondCount() const { return microsecondCount / Period::microsecondPerSecond; }
 
     Date getDay() const;
 
     Period getTime() const;
 
-    static long long composeSecondCount(const Date &day, const Period &time);
-
-    // parsing
+    static long long composeMicrosecondCount(const Date &day, const Period &time);
 
-    static Date parseDay(const std::string &asString);
+    // parse date and time around delimiter in single pass, false if malformed
 
-    static Period parseTime(const std::string &asString);
+    static bool parse(const char *data, std::size_t size, Moment *result);
 
-    static Moment parseWithNow(const std::string &asString);
+    // write formatted moment with terminator into buffer of buffer char count and return char count
 
-    // get current moment
-
-    static Moment now();
+    int format(char *result) const;
 
     // to string operator
 
@@ -327,11 +374,23 @@ public:
 
     friend std::ostream &operator<<(std::ostream &stream, const Moment &moment);
 
+    friend TextWriter &operator<<(TextWriter &stream, const Moment &moment);
+
     friend std::istream &operator>>(std::istream &stream, Moment &moment);
 
     // file io
 
-    const std::ostream &exportFull(std::ostream &stream, bool newObject) const override;
+    const std::ostream &exportFull(std::ostream &stream, bool newObject) const;
+
+    const TextWriter &exportFull(TextWriter &stream, bool newObject) const;
 
     static Moment *importFull(std::istream &stream, Moment *result, bool newObject);
+
+    static Moment *importFull(TextScanner &stream, Moment *result, bool newObject);
+
+    // binary file io
+
+    BinaryWriter &exportBinary(BinaryWriter &writer, bool newObject) const;
+
+    static Moment *importBinary(BinaryReader &reader, Moment *result, bool newObject);
 };